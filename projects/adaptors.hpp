@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "iterator.hpp"
+
+// Lazy range adaptors built on iterator_facade. Every stage wraps the iterator
+// of the previous one, so a chain like
+//     list | views::filter(p) | views::transform(f) | views::take_while(q)
+// runs as a single pass over list without intermediate containers.
+// An lvalue range is referenced, an rvalue range (e.g. an inner view or a
+// zip_range) is moved into the view. Iterators refer to their view, so the view
+// must outlive them.
+
+namespace exp::views {
+
+namespace details {
+
+template<typename R>
+using iterator_t = decltype(std::begin(std::declval<R&>()));
+
+template<typename R>
+using reference_t = std::iter_reference_t<iterator_t<R>>;
+
+template<typename It>
+using category_t = typename std::iterator_traits<It>::iterator_category;
+
+// Category of an adaptor that keeps the traversal of It, up to random access.
+template<typename It>
+using random_access_at_most = std::conditional_t<
+    std::is_base_of_v<std::random_access_iterator_tag, category_t<It>>,
+    std::random_access_iterator_tag,
+    std::conditional_t<
+        std::is_base_of_v<std::bidirectional_iterator_tag, category_t<It>>,
+        std::bidirectional_iterator_tag,
+        std::forward_iterator_tag>>;
+
+template<typename R>
+concept range = requires(R& r) {
+    std::begin(r);
+    std::end(r);
+};
+
+// Result of range | closure, make_ builds the view.
+template<typename Make>
+struct adaptor_closure {
+    Make make_;
+
+    template<range R>
+    friend auto operator|(R&& r, const adaptor_closure& closure) {
+        return closure.make_(std::forward<R>(r));
+    }
+};
+
+template<typename Make>
+adaptor_closure(Make) -> adaptor_closure<Make>;
+
+// Steps it forward by up to n elements without passing last.
+template<typename It>
+void advance_bounded(It& it, const It& last, std::size_t n) {
+    for(; n > 0 && it != last; --n) {
+        ++it;
+    }
+}
+
+} // namespace details
+
+// Pair of iterators usable in range-for, the element type of chunk_view.
+template<typename It>
+class subrange {
+public:
+    subrange() = default;
+    subrange(It first, It last): first_(first), last_(last) {}
+
+    It begin() const { return first_; }
+    It end() const { return last_; }
+    std::size_t size() const { return static_cast<std::size_t>(std::distance(first_, last_)); }
+private:
+    It first_{};
+    It last_{};
+};
+
+// ============= transform ============= //
+
+template<typename R, typename F>
+class transform_view {
+public:
+    using base_iterator = details::iterator_t<R>;
+    using reference = std::invoke_result_t<const F&, details::reference_t<R>>;
+
+    class iterator: public iterator_facade<iterator, std::remove_cvref_t<reference>, details::random_access_at_most<base_iterator>, reference> {
+    public:
+        iterator() = default;
+        iterator(base_iterator it, const F* func): it_(it), func_(func) {}
+
+        reference dereference() const { return std::invoke(*func_, *it_); }
+        void increment() { ++it_; }
+        void decrement() { --it_; }
+        void advance(std::ptrdiff_t n) requires std::random_access_iterator<base_iterator> { it_ += n; }
+        std::ptrdiff_t distance_to(const iterator& other) const requires std::random_access_iterator<base_iterator> { return other.it_ - it_; }
+        bool equal(const iterator& other) const { return it_ == other.it_; }
+    private:
+        base_iterator it_{};
+        const F* func_ = nullptr;
+    };
+
+    transform_view(R&& range, F func): range_(std::forward<R>(range)), func_(std::move(func)) {}
+
+    iterator begin() { return iterator(std::begin(range_), &func_); }
+    iterator end() { return iterator(std::end(range_), &func_); }
+
+    std::size_t size() const requires requires(const std::remove_reference_t<R>& r) { std::size(r); } { return std::size(range_); }
+private:
+    R range_;
+    F func_;
+};
+
+// ============= filter ============= //
+
+template<typename R, typename P>
+class filter_view {
+public:
+    using base_iterator = details::iterator_t<R>;
+    using reference = details::reference_t<R>;
+
+    class iterator: public iterator_facade<iterator, std::remove_cvref_t<reference>, std::forward_iterator_tag, reference> {
+    public:
+        iterator() = default;
+        iterator(base_iterator it, base_iterator last, const P* pred): it_(it), last_(last), pred_(pred) {
+            skip();
+        }
+
+        reference dereference() const { return *it_; }
+        void increment() {
+            ++it_;
+            skip();
+        }
+        bool equal(const iterator& other) const { return it_ == other.it_; }
+    private:
+        void skip() {
+            while(it_ != last_ && !std::invoke(*pred_, *it_)) {
+                ++it_;
+            }
+        }
+
+        base_iterator it_{};
+        base_iterator last_{};
+        const P* pred_ = nullptr;
+    };
+
+    filter_view(R&& range, P pred): range_(std::forward<R>(range)), pred_(std::move(pred)) {}
+
+    iterator begin() { return iterator(std::begin(range_), std::end(range_), &pred_); }
+    iterator end() { return iterator(std::end(range_), std::end(range_), &pred_); }
+private:
+    R range_;
+    P pred_;
+};
+
+// ============= take_while ============= //
+
+template<typename R, typename P>
+class take_while_view {
+public:
+    using base_iterator = details::iterator_t<R>;
+    using reference = details::reference_t<R>;
+
+    // Iterators past the first rejected element all compare equal to end().
+    class iterator: public iterator_facade<iterator, std::remove_cvref_t<reference>, std::forward_iterator_tag, reference> {
+    public:
+        iterator() = default;
+        iterator(base_iterator it, base_iterator last, const P* pred): it_(it), last_(last), pred_(pred) {
+            check();
+        }
+
+        reference dereference() const { return *it_; }
+        void increment() {
+            ++it_;
+            check();
+        }
+        bool equal(const iterator& other) const { return done_ == other.done_ && (done_ || it_ == other.it_); }
+    private:
+        void check() { done_ = it_ == last_ || !std::invoke(*pred_, *it_); }
+
+        base_iterator it_{};
+        base_iterator last_{};
+        const P* pred_ = nullptr;
+        bool done_ = true;
+    };
+
+    take_while_view(R&& range, P pred): range_(std::forward<R>(range)), pred_(std::move(pred)) {}
+
+    iterator begin() { return iterator(std::begin(range_), std::end(range_), &pred_); }
+    iterator end() { return iterator(std::end(range_), std::end(range_), &pred_); }
+private:
+    R range_;
+    P pred_;
+};
+
+// ============= enumerate ============= //
+
+template<typename R>
+class enumerate_view {
+public:
+    using base_iterator = details::iterator_t<R>;
+    using reference = std::tuple<std::size_t, details::reference_t<R>>;
+
+    class iterator: public iterator_facade<iterator, std::tuple<std::size_t, std::iter_value_t<base_iterator>>, details::random_access_at_most<base_iterator>, reference> {
+    public:
+        iterator() = default;
+        iterator(base_iterator it, std::size_t idx): it_(it), idx_(idx) {}
+
+        reference dereference() const { return reference(idx_, *it_); }
+        void increment() {
+            ++it_;
+            ++idx_;
+        }
+        void decrement() {
+            --it_;
+            --idx_;
+        }
+        void advance(std::ptrdiff_t n) requires std::random_access_iterator<base_iterator> {
+            it_ += n;
+            idx_ += static_cast<std::size_t>(n);
+        }
+        std::ptrdiff_t distance_to(const iterator& other) const requires std::random_access_iterator<base_iterator> { return other.it_ - it_; }
+        bool equal(const iterator& other) const { return it_ == other.it_; }
+    private:
+        base_iterator it_{};
+        std::size_t idx_{};
+    };
+
+    explicit enumerate_view(R&& range): range_(std::forward<R>(range)) {}
+
+    iterator begin() { return iterator(std::begin(range_), 0); }
+    // The index of end() is only right for sized ranges, it is not used by equal().
+    iterator end() {
+        if constexpr (requires { std::size(range_); }) {
+            return iterator(std::end(range_), std::size(range_));
+        } else {
+            return iterator(std::end(range_), 0);
+        }
+    }
+
+    std::size_t size() const requires requires(const std::remove_reference_t<R>& r) { std::size(r); } { return std::size(range_); }
+private:
+    R range_;
+};
+
+// ============= chunk ============= //
+
+template<typename R>
+class chunk_view {
+public:
+    using base_iterator = details::iterator_t<R>;
+    using reference = subrange<base_iterator>;
+
+    // Chunks of n consecutive elements, the last one may be shorter.
+    class iterator: public iterator_facade<iterator, reference, std::forward_iterator_tag, reference> {
+    public:
+        iterator() = default;
+        iterator(base_iterator it, base_iterator last, std::size_t n): it_(it), next_(it), last_(last), n_(n) {
+            details::advance_bounded(next_, last_, n_);
+        }
+
+        reference dereference() const { return reference(it_, next_); }
+        void increment() {
+            it_ = next_;
+            details::advance_bounded(next_, last_, n_);
+        }
+        bool equal(const iterator& other) const { return it_ == other.it_; }
+    private:
+        base_iterator it_{};
+        base_iterator next_{};
+        base_iterator last_{};
+        std::size_t n_{};
+    };
+
+    chunk_view(R&& range, std::size_t n): range_(std::forward<R>(range)), n_(n > 0 ? n : 1) {}
+
+    iterator begin() { return iterator(std::begin(range_), std::end(range_), n_); }
+    iterator end() { return iterator(std::end(range_), std::end(range_), n_); }
+private:
+    R range_;
+    std::size_t n_;
+};
+
+// ============= stride ============= //
+
+template<typename R>
+class stride_view {
+public:
+    using base_iterator = details::iterator_t<R>;
+    using reference = details::reference_t<R>;
+
+    // Every n-th element starting with the first.
+    class iterator: public iterator_facade<iterator, std::remove_cvref_t<reference>, std::forward_iterator_tag, reference> {
+    public:
+        iterator() = default;
+        iterator(base_iterator it, base_iterator last, std::size_t n): it_(it), last_(last), n_(n) {}
+
+        reference dereference() const { return *it_; }
+        void increment() { details::advance_bounded(it_, last_, n_); }
+        bool equal(const iterator& other) const { return it_ == other.it_; }
+    private:
+        base_iterator it_{};
+        base_iterator last_{};
+        std::size_t n_{};
+    };
+
+    stride_view(R&& range, std::size_t n): range_(std::forward<R>(range)), n_(n > 0 ? n : 1) {}
+
+    iterator begin() { return iterator(std::begin(range_), std::end(range_), n_); }
+    iterator end() { return iterator(std::end(range_), std::end(range_), n_); }
+private:
+    R range_;
+    std::size_t n_;
+};
+
+// ============= Pipe closures ============= //
+
+template<typename F>
+auto transform(F func) {
+    return details::adaptor_closure{[func = std::move(func)]<typename R>(R&& range) {
+        return transform_view<R, F>(std::forward<R>(range), func);
+    }};
+}
+
+template<typename P>
+auto filter(P pred) {
+    return details::adaptor_closure{[pred = std::move(pred)]<typename R>(R&& range) {
+        return filter_view<R, P>(std::forward<R>(range), pred);
+    }};
+}
+
+template<typename P>
+auto take_while(P pred) {
+    return details::adaptor_closure{[pred = std::move(pred)]<typename R>(R&& range) {
+        return take_while_view<R, P>(std::forward<R>(range), pred);
+    }};
+}
+
+inline auto enumerate() {
+    return details::adaptor_closure{[]<typename R>(R&& range) {
+        return enumerate_view<R>(std::forward<R>(range));
+    }};
+}
+
+inline auto chunk(std::size_t n) {
+    return details::adaptor_closure{[n]<typename R>(R&& range) {
+        return chunk_view<R>(std::forward<R>(range), n);
+    }};
+}
+
+inline auto stride(std::size_t n) {
+    return details::adaptor_closure{[n]<typename R>(R&& range) {
+        return stride_view<R>(std::forward<R>(range), n);
+    }};
+}
+
+} // namespace exp::views
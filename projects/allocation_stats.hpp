@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace exp {
+
+struct allocation_snapshot {
+	std::string name_;
+	std::uint64_t allocations_;
+	std::uint64_t deallocations_;
+	std::uint64_t live_objects_;
+	std::uint64_t peak_objects_;
+	std::uint64_t live_bytes_;
+	std::uint64_t peak_bytes_;
+	// Bytes of live objects that hold user data, live_bytes_ - payload_bytes_ is the
+	// per-node overhead (links, chunk headers, padding).
+	std::uint64_t payload_bytes_;
+};
+
+// Counters for one named group of containers, safe to update from any thread.
+class allocation_stats {
+public:
+	explicit allocation_stats(std::string name): name_(std::move(name)) {}
+
+	void on_allocate(std::size_t objects, std::size_t bytes, std::size_t payload_bytes, std::size_t calls = 1) noexcept {
+		allocations_.fetch_add(calls, std::memory_order_relaxed);
+		updatePeak(peak_objects_, live_objects_.fetch_add(objects, std::memory_order_relaxed) + objects);
+		updatePeak(peak_bytes_, live_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+		payload_bytes_.fetch_add(payload_bytes, std::memory_order_relaxed);
+	}
+
+	void on_deallocate(std::size_t objects, std::size_t bytes, std::size_t payload_bytes) noexcept {
+		deallocations_.fetch_add(1, std::memory_order_relaxed);
+		live_objects_.fetch_sub(objects, std::memory_order_relaxed);
+		live_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+		payload_bytes_.fetch_sub(payload_bytes, std::memory_order_relaxed);
+	}
+
+	const std::string& name() const noexcept { return name_; }
+
+	allocation_snapshot snapshot() const {
+		return {
+			name_,
+			allocations_.load(std::memory_order_relaxed),
+			deallocations_.load(std::memory_order_relaxed),
+			live_objects_.load(std::memory_order_relaxed),
+			peak_objects_.load(std::memory_order_relaxed),
+			live_bytes_.load(std::memory_order_relaxed),
+			peak_bytes_.load(std::memory_order_relaxed),
+			payload_bytes_.load(std::memory_order_relaxed)
+		};
+	}
+
+private:
+	static void updatePeak(std::atomic<std::uint64_t>& peak, std::uint64_t value) noexcept {
+		std::uint64_t curr = peak.load(std::memory_order_relaxed);
+		while(value > curr && !peak.compare_exchange_weak(curr, value, std::memory_order_relaxed)) {}
+	}
+
+	std::string name_;
+	std::atomic<std::uint64_t> allocations_{0};
+	std::atomic<std::uint64_t> deallocations_{0};
+	std::atomic<std::uint64_t> live_objects_{0};
+	std::atomic<std::uint64_t> peak_objects_{0};
+	std::atomic<std::uint64_t> live_bytes_{0};
+	std::atomic<std::uint64_t> peak_bytes_{0};
+	std::atomic<std::uint64_t> payload_bytes_{0};
+};
+
+// Process-wide set of named allocation_stats. Entries are never removed, so
+// references handed out stay valid.
+class allocation_registry {
+public:
+	static allocation_registry& global() {
+		static allocation_registry registry;
+		return registry;
+	}
+
+	allocation_stats& get(std::string_view name) {
+		std::lock_guard lock(mutex_);
+		for(auto& stats : stats_) {
+			if(stats->name() == name) {
+				return *stats;
+			}
+		}
+		return *stats_.emplace_back(std::make_unique<allocation_stats>(std::string(name)));
+	}
+
+	std::vector<allocation_snapshot> snapshot() {
+		std::lock_guard lock(mutex_);
+		std::vector<allocation_snapshot> result;
+		result.reserve(stats_.size());
+		for(const auto& stats : stats_) {
+			result.push_back(stats->snapshot());
+		}
+		return result;
+	}
+
+	void dump(std::ostream& os) {
+		os << "name | live objects | peak objects | allocations | deallocations | live bytes | peak bytes | overhead bytes\n";
+		for(const auto& snap : snapshot()) {
+			os << snap.name_ << " | " << snap.live_objects_ << " | " << snap.peak_objects_ << " | "
+			   << snap.allocations_ << " | " << snap.deallocations_ << " | " << snap.live_bytes_ << " | "
+			   << snap.peak_bytes_ << " | " << snap.live_bytes_ - snap.payload_bytes_ << '\n';
+		}
+	}
+
+private:
+	allocation_registry() = default;
+
+	std::mutex mutex_;
+	std::vector<std::unique_ptr<allocation_stats>> stats_;
+};
+
+namespace details {
+
+// Containers expose the user data held by a node as Node::payload_type.
+template<typename T>
+constexpr std::size_t payload_size() noexcept {
+	if constexpr (requires { typename T::payload_type; }) {
+		return sizeof(typename T::payload_type);
+	} else {
+		return sizeof(T);
+	}
+}
+
+// The registry never removes entries, so the "default" one is looked up, under
+// the registry lock, once per process instead of per allocator.
+inline allocation_stats& default_stats() {
+	static allocation_stats& stats = allocation_registry::global().get("default");
+	return stats;
+}
+
+} // namespace details
+
+// Allocator policy recording every allocation of the Base allocator into an
+// allocation_stats entry of the global registry. Rebinding keeps the entry, so all
+// node allocations of a container land in the stats it was constructed with.
+template<typename T, typename Base = std::allocator<T>>
+class stats_allocator {
+	template<typename U, typename B>
+	friend class stats_allocator;
+
+	using base_traits = std::allocator_traits<Base>;
+public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = typename base_traits::propagate_on_container_copy_assignment;
+	using propagate_on_container_move_assignment = typename base_traits::propagate_on_container_move_assignment;
+	using propagate_on_container_swap = typename base_traits::propagate_on_container_swap;
+	using is_always_equal = std::false_type;
+
+	template<typename U>
+	struct rebind {
+		using other = stats_allocator<U, typename base_traits::template rebind_alloc<U>>;
+	};
+
+	stats_allocator(): stats_allocator(details::default_stats()) {}
+	explicit stats_allocator(std::string_view name, const Base& base = Base()): stats_allocator(allocation_registry::global().get(name), base) {}
+	explicit stats_allocator(allocation_stats& stats, const Base& base = Base()): base_(base), stats_(&stats) {}
+
+	template<typename U, typename B>
+	stats_allocator(const stats_allocator<U, B>& other): base_(other.base_), stats_(other.stats_) {}
+
+	T* allocate(std::size_t n) {
+		T* ptr = base_traits::allocate(base_, n);
+		stats_->on_allocate(n, n * sizeof(T), n * details::payload_size<T>());
+		return ptr;
+	}
+
+	T* allocate_bulk(std::size_t n) requires requires(Base& base) { base.allocate_bulk(n); } {
+		T* ptr = base_.allocate_bulk(n);
+		// Bulk blocks are freed one by one, so they count as n allocations.
+		stats_->on_allocate(n, n * sizeof(T), n * details::payload_size<T>(), n);
+		return ptr;
+	}
+
+	void deallocate(T* ptr, std::size_t n) noexcept {
+		base_traits::deallocate(base_, ptr, n);
+		stats_->on_deallocate(n, n * sizeof(T), n * details::payload_size<T>());
+	}
+
+	stats_allocator select_on_container_copy_construction() const {
+		return stats_allocator(*stats_, base_traits::select_on_container_copy_construction(base_));
+	}
+
+	allocation_stats& stats() const noexcept { return *stats_; }
+	const Base& base() const noexcept { return base_; }
+
+	friend bool operator==(const stats_allocator& lhs, const stats_allocator& rhs) noexcept {
+		return lhs.stats_ == rhs.stats_ && lhs.base_ == rhs.base_;
+	}
+
+private:
+	[[no_unique_address]] Base base_;
+	allocation_stats* stats_;
+};
+
+// Default allocator of the exp containers: plain std::allocator, or stats_allocator
+// reporting to the "default" entry when built with EXP_ALLOCATION_STATS.
+#if defined(EXP_ALLOCATION_STATS)
+template<typename T>
+using default_allocator = stats_allocator<T>;
+#else
+template<typename T>
+using default_allocator = std::allocator<T>;
+#endif
+
+} // namespace exp
@@ -0,0 +1,866 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <list>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <numeric>
+#include <ranges>
+#include "list.hpp"
+#include "iterator.hpp"
+#include "pool_allocator.hpp"
+#include "unrolled_list.hpp"
+#include "compact_list.hpp"
+#include "ring_deque.hpp"
+#include "zip_kernels.hpp"
+#include "soa_vector.hpp"
+#include "intrusive_list.hpp"
+#include "prng.hpp"
+#include "adaptors.hpp"
+#include "skip_list.hpp"
+#include "mapped_list.hpp"
+#include "lru_cache.hpp"
+
+template<std::size_t Bytes>
+struct payload {
+    payload() = default;
+    payload(std::size_t val) { data[0] = static_cast<unsigned char>(val); }
+
+    std::array<unsigned char, Bytes> data{};
+};
+
+template<typename T>
+unsigned char first_byte(const T& val) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        return static_cast<unsigned char>(val);
+    } else {
+        return val.data[0];
+    }
+}
+
+template<typename T>
+using pool_list = exp::list<T, exp::pool_allocator<T>>;
+
+// Pointer iterator routed through iterator_facade, to price the facade itself.
+template<typename T>
+class facade_ptr_iterator: public iterator_facade<facade_ptr_iterator<T>, T, std::bidirectional_iterator_tag> {
+public:
+    explicit facade_ptr_iterator(T* ptr) noexcept: ptr_(ptr) {}
+
+    T& dereference() const noexcept { return *ptr_; }
+    void increment() noexcept { ++ptr_; }
+    void decrement() noexcept { --ptr_; }
+    bool equal(const facade_ptr_iterator& other) const noexcept { return ptr_ == other.ptr_; }
+private:
+    T* ptr_;
+};
+
+template<typename T>
+void set_counters(benchmark::State& state, std::size_t n) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n * sizeof(T)));
+}
+
+// ============= Containers ============= //
+
+template<typename Cont>
+void BM_push_back(benchmark::State& state) {
+    using T = typename Cont::value_type;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for(auto _ : state) {
+        Cont cont;
+        for(std::size_t i = 0; i < n; ++i) {
+            cont.push_back(T(i));
+        }
+        benchmark::DoNotOptimize(cont);
+    }
+    set_counters<T>(state, n);
+}
+
+template<typename Cont>
+void BM_push_front(benchmark::State& state) {
+    using T = typename Cont::value_type;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for(auto _ : state) {
+        Cont cont;
+        for(std::size_t i = 0; i < n; ++i) {
+            cont.push_front(T(i));
+        }
+        benchmark::DoNotOptimize(cont);
+    }
+    set_counters<T>(state, n);
+}
+
+template<typename Cont>
+void BM_emplace_back(benchmark::State& state) {
+    using T = typename Cont::value_type;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for(auto _ : state) {
+        Cont cont;
+        for(std::size_t i = 0; i < n; ++i) {
+            cont.emplace_back(i);
+        }
+        benchmark::DoNotOptimize(cont);
+    }
+    set_counters<T>(state, n);
+}
+
+// Erases every element from the front, the build is excluded from the timing.
+template<typename Cont>
+void BM_erase(benchmark::State& state) {
+    using T = typename Cont::value_type;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for(auto _ : state) {
+        state.PauseTiming();
+        Cont cont;
+        for(std::size_t i = 0; i < n; ++i) {
+            cont.push_back(T(i));
+        }
+        state.ResumeTiming();
+        while(cont.begin() != cont.end()) {
+            cont.erase(cont.begin());
+        }
+        benchmark::DoNotOptimize(cont);
+    }
+    set_counters<T>(state, n);
+}
+
+template<typename Cont>
+void BM_iterate(benchmark::State& state) {
+    using T = typename Cont::value_type;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Cont cont;
+    for(std::size_t i = 0; i < n; ++i) {
+        cont.push_back(T(i));
+    }
+    for(auto _ : state) {
+        std::size_t sum{};
+        for(const auto& el : cont) {
+            sum += first_byte(el);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<T>(state, n);
+}
+
+#define CONTAINER_BENCHMARKS(BM, T)                                         \
+    BENCHMARK_TEMPLATE(BM, exp::list<T>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM, pool_list<T>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM, exp::unrolled_list<T>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM, exp::unrolled_list<T, 512>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM, exp::compact_list<T>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM, std::list<T>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)
+
+#define ALL_SIZES(BM)                   \
+    CONTAINER_BENCHMARKS(BM, int);          \
+    CONTAINER_BENCHMARKS(BM, payload<64>);  \
+    CONTAINER_BENCHMARKS(BM, payload<256>)
+
+ALL_SIZES(BM_push_back);
+ALL_SIZES(BM_push_front);
+ALL_SIZES(BM_emplace_back);
+ALL_SIZES(BM_erase);
+ALL_SIZES(BM_iterate);
+
+// Builds and scans a list of range(0) ints, reporting the bytes per element
+// requested from the allocator (heap block headers not included).
+template<typename Cont>
+void BM_large_list_footprint(benchmark::State& state) {
+    using alloc = typename Cont::allocator_type;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto& stats = exp::allocation_registry::global().get("bench.footprint");
+    double bytes_per_element{};
+    for(auto _ : state) {
+        Cont cont{alloc(stats)};
+        for(std::size_t i = 0; i < n; ++i) {
+            cont.push_back(static_cast<int>(i));
+        }
+        std::size_t sum{};
+        for(int x : cont) {
+            sum += static_cast<std::size_t>(x);
+        }
+        benchmark::DoNotOptimize(sum);
+        bytes_per_element = static_cast<double>(stats.snapshot().live_bytes_) / static_cast<double>(n);
+    }
+    state.counters["bytes_per_element"] = bytes_per_element;
+    set_counters<int>(state, n);
+}
+
+BENCHMARK_TEMPLATE(BM_large_list_footprint, exp::list<int, exp::stats_allocator<int>>)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_large_list_footprint, exp::compact_list<int, exp::stats_allocator<int>>)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_push_back, std::vector<int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_emplace_back, std::vector<int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_iterate, std::vector<int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+template<typename Cont>
+void BM_bulk_append(benchmark::State& state) {
+    using T = typename Cont::value_type;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<T> src(n, T(1));
+    for(auto _ : state) {
+        Cont cont;
+        if constexpr (requires { cont.append(src.begin(), src.end()); }) {
+            cont.append(src.begin(), src.end());
+        } else {
+            cont.insert(cont.end(), src.begin(), src.end());
+        }
+        benchmark::DoNotOptimize(cont);
+    }
+    set_counters<T>(state, n);
+}
+
+BENCHMARK_TEMPLATE(BM_bulk_append, exp::list<int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_bulk_append, pool_list<int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_bulk_append, exp::unrolled_list<int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_bulk_append, std::vector<int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_bulk_append, std::list<int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// Periodic rebuild of a list from another one of similar length: assignment
+// reuses the destination's nodes, a fresh copy reallocates all of them.
+void BM_rebuild_by_assignment(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    exp::list<int> src(n, 1);
+    exp::list<int> dst(n - n / 8, 2);
+    for(auto _ : state) {
+        dst = src;
+        benchmark::DoNotOptimize(dst);
+    }
+    set_counters<int>(state, n);
+}
+
+void BM_rebuild_by_copy(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    exp::list<int> src(n, 1);
+    exp::list<int> dst(n - n / 8, 2);
+    for(auto _ : state) {
+        dst = exp::list<int>(src);
+        benchmark::DoNotOptimize(dst);
+    }
+    set_counters<int>(state, n);
+}
+
+BENCHMARK(BM_rebuild_by_assignment)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_rebuild_by_copy)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// Many short-lived lists of range(0) elements, the common case for small_list.
+template<typename Cont>
+void BM_short_lists(benchmark::State& state) {
+    const auto len = static_cast<int>(state.range(0));
+    constexpr std::size_t lists = 1024;
+    for(auto _ : state) {
+        int sum = 0;
+        for(std::size_t i = 0; i < lists; ++i) {
+            Cont cont;
+            for(int j = 0; j < len; ++j) {
+                cont.push_back(j);
+            }
+            for(int x : cont) {
+                sum += x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<int>(state, lists * static_cast<std::size_t>(len));
+}
+
+BENCHMARK_TEMPLATE(BM_short_lists, exp::list<int>)->RangeMultiplier(2)->Range(1, 16);
+BENCHMARK_TEMPLATE(BM_short_lists, exp::small_list<int, 8>)->RangeMultiplier(2)->Range(1, 16);
+BENCHMARK_TEMPLATE(BM_short_lists, std::list<int>)->RangeMultiplier(2)->Range(1, 16);
+
+// ============= Sort and merge ============= //
+
+template<typename T>
+std::vector<T> random_values(std::size_t n) {
+    exp::xoshiro256 engine(42);
+    std::vector<T> values;
+    values.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        values.emplace_back(exp::uniform_int<std::size_t>(engine, 0, 255));
+    }
+    return values;
+}
+
+struct first_byte_less {
+    template<typename T>
+    bool operator()(const T& lhs, const T& rhs) const noexcept { return first_byte(lhs) < first_byte(rhs); }
+};
+
+template<typename Cont>
+void BM_sort(benchmark::State& state) {
+    using T = typename Cont::value_type;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto values = random_values<T>(n);
+    for(auto _ : state) {
+        state.PauseTiming();
+        Cont cont;
+        for(const auto& val : values) {
+            cont.push_back(val);
+        }
+        state.ResumeTiming();
+        cont.sort(first_byte_less{});
+        benchmark::DoNotOptimize(cont);
+    }
+    set_counters<T>(state, n);
+}
+
+template<typename Cont>
+void BM_merge(benchmark::State& state) {
+    using T = typename Cont::value_type;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for(auto _ : state) {
+        state.PauseTiming();
+        // merge needs sorted inputs and, for exp::list, equal allocators: pool_list
+        // nodes have to come from the same pools.
+        Cont lhs;
+        Cont rhs(lhs.get_allocator());
+        for(std::size_t i = 0; i < n; ++i) {
+            (i % 2 ? lhs : rhs).push_back(T(i * 256 / n));
+        }
+        state.ResumeTiming();
+        lhs.merge(rhs, first_byte_less{});
+        benchmark::DoNotOptimize(lhs);
+    }
+    set_counters<T>(state, n);
+}
+
+#define SORT_BENCHMARKS(BM, T)                                              \
+    BENCHMARK_TEMPLATE(BM, exp::list<T>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM, pool_list<T>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM, std::list<T>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)
+
+SORT_BENCHMARKS(BM_sort, int);
+SORT_BENCHMARKS(BM_sort, payload<64>);
+SORT_BENCHMARKS(BM_merge, int);
+SORT_BENCHMARKS(BM_merge, payload<64>);
+
+// ============= Intrusive list ============= //
+
+struct bench_session {
+    std::size_t id;
+    exp::list_hook hook;
+};
+
+// Moves a pseudo random element to the back of the list, LRU style.
+void BM_intrusive_touch(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<bench_session> sessions(n);
+    exp::intrusive_list<bench_session, &bench_session::hook> lru;
+    for(std::size_t i = 0; i < n; ++i) {
+        sessions[i].id = i;
+        lru.push_back(sessions[i]);
+    }
+    std::size_t idx = 0;
+    for(auto _ : state) {
+        idx = (idx * 7 + 13) % n;
+        lru.remove(sessions[idx]);
+        lru.push_back(sessions[idx]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Same pattern with an owning list: erase the node and allocate a new one.
+template<typename Cont>
+void BM_owning_touch(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Cont lru;
+    std::vector<typename Cont::iterator> positions;
+    for(std::size_t i = 0; i < n; ++i) {
+        lru.push_back(i);
+        positions.push_back(--lru.end());
+    }
+    std::size_t idx = 0;
+    for(auto _ : state) {
+        idx = (idx * 7 + 13) % n;
+        lru.erase(positions[idx]);
+        lru.push_back(idx);
+        positions[idx] = --lru.end();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_intrusive_touch)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_owning_touch, exp::list<std::size_t>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_owning_touch, pool_list<std::size_t>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_owning_touch, std::list<std::size_t>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// ============= iterator_facade ============= //
+
+template<typename T>
+void BM_facade_iterate(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<T> vec(n, T(1));
+    for(auto _ : state) {
+        std::size_t sum{};
+        for(auto it = facade_ptr_iterator(vec.data()), end = facade_ptr_iterator(vec.data() + n); it != end; ++it) {
+            sum += first_byte(*it);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<T>(state, n);
+}
+
+template<typename T>
+void BM_raw_ptr_iterate(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<T> vec(n, T(1));
+    for(auto _ : state) {
+        std::size_t sum{};
+        for(auto it = vec.data(), end = vec.data() + n; it != end; ++it) {
+            sum += first_byte(*it);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<T>(state, n);
+}
+
+BENCHMARK_TEMPLATE(BM_facade_iterate, int)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_raw_ptr_iterate, int)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_facade_iterate, payload<64>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_raw_ptr_iterate, payload<64>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// ============= zip_range ============= //
+
+template<typename T, std::size_t... I>
+void zip_bench_impl(benchmark::State& state, std::index_sequence<I...>) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::array<std::vector<T>, sizeof...(I)> columns;
+    for(auto& col : columns) {
+        col.assign(n, T(1));
+    }
+    for(auto _ : state) {
+        T sum{};
+        for(const auto& row : make_zip_range(columns[I]...)) {
+            sum += (std::get<I>(row) + ...);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<T>(state, n * sizeof...(I));
+}
+
+template<typename T, std::size_t Ranges>
+void BM_zip_range(benchmark::State& state) {
+    zip_bench_impl<T>(state, std::make_index_sequence<Ranges>{});
+}
+
+template<typename T, std::size_t... I>
+void index_loop_impl(benchmark::State& state, std::index_sequence<I...>) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::array<std::vector<T>, sizeof...(I)> columns;
+    for(auto& col : columns) {
+        col.assign(n, T(1));
+    }
+    for(auto _ : state) {
+        T sum{};
+        for(std::size_t idx = 0; idx < n; ++idx) {
+            sum += (columns[I][idx] + ...);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<T>(state, n * sizeof...(I));
+}
+
+template<typename T, std::size_t Ranges>
+void BM_zip_index_loop(benchmark::State& state) {
+    index_loop_impl<T>(state, std::make_index_sequence<Ranges>{});
+}
+
+#define ZIP_BENCHMARKS(BM, T)                                               \
+    BENCHMARK_TEMPLATE(BM, T, 2)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM, T, 3)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM, T, 4)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)
+
+template<typename T, std::size_t... I>
+void zip_reduce_impl(benchmark::State& state, std::index_sequence<I...>) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::array<std::vector<T>, sizeof...(I)> columns;
+    for(auto& col : columns) {
+        col.assign(n, T(1));
+    }
+    auto range = make_zip_range(columns[I]...);
+    for(auto _ : state) {
+        T sum = exp::zip_reduce(range, T{}, std::plus<>{}, exp::folded<std::plus<>>{});
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<T>(state, n * sizeof...(I));
+}
+
+template<typename T, std::size_t Ranges>
+void BM_zip_reduce_kernel(benchmark::State& state) {
+    zip_reduce_impl<T>(state, std::make_index_sequence<Ranges>{});
+}
+
+template<typename T, std::size_t... I>
+void zip_transform_impl(benchmark::State& state, std::index_sequence<I...>) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::array<std::vector<T>, sizeof...(I)> columns;
+    for(auto& col : columns) {
+        col.assign(n, T(1));
+    }
+    std::vector<T> out(n);
+    auto range = make_zip_range(columns[I]...);
+    for(auto _ : state) {
+        exp::zip_transform(range, out.begin(), exp::folded<std::multiplies<>>{});
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters<T>(state, n * (sizeof...(I) + 1));
+}
+
+template<typename T, std::size_t Ranges>
+void BM_zip_transform_kernel(benchmark::State& state) {
+    zip_transform_impl<T>(state, std::make_index_sequence<Ranges>{});
+}
+
+ZIP_BENCHMARKS(BM_zip_range, int);
+ZIP_BENCHMARKS(BM_zip_range, double);
+ZIP_BENCHMARKS(BM_zip_index_loop, int);
+ZIP_BENCHMARKS(BM_zip_index_loop, double);
+ZIP_BENCHMARKS(BM_zip_reduce_kernel, int);
+ZIP_BENCHMARKS(BM_zip_reduce_kernel, float);
+ZIP_BENCHMARKS(BM_zip_reduce_kernel, double);
+ZIP_BENCHMARKS(BM_zip_transform_kernel, int);
+ZIP_BENCHMARKS(BM_zip_transform_kernel, float);
+ZIP_BENCHMARKS(BM_zip_transform_kernel, double);
+
+// ============= soa_vector ============= //
+
+struct telemetry_row {
+    std::int64_t timestamp;
+    double value;
+    float weight;
+    std::int32_t sensor;
+};
+
+// Weighted sum over two fields of a four-field row, AoS against SoA.
+void BM_aos_weighted_sum(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<telemetry_row> rows(n, telemetry_row{0, 1.0, 0.5f, 0});
+    for(auto _ : state) {
+        double sum = 0;
+        for(const auto& row : rows) {
+            sum += row.value * row.weight;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<telemetry_row>(state, n);
+}
+
+void BM_soa_weighted_sum(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    exp::soa_vector<std::int64_t, double, float, std::int32_t> rows;
+    rows.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        rows.emplace_back(0, 1.0, 0.5f, 0);
+    }
+    for(auto _ : state) {
+        const double* values = rows.data<1>();
+        const float* weights = rows.data<2>();
+        double sum = 0;
+        for(std::size_t i = 0; i < n; ++i) {
+            sum += values[i] * weights[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<telemetry_row>(state, n);
+}
+
+void BM_soa_push_back(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for(auto _ : state) {
+        exp::soa_vector<std::int64_t, double, float, std::int32_t> rows;
+        for(std::size_t i = 0; i < n; ++i) {
+            rows.emplace_back(static_cast<std::int64_t>(i), 1.0, 0.5f, 0);
+        }
+        benchmark::DoNotOptimize(rows);
+    }
+    set_counters<telemetry_row>(state, n);
+}
+
+BENCHMARK(BM_aos_weighted_sum)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_soa_weighted_sum)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_soa_push_back)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// ============= Ordered index ============= //
+
+// Time-ordered events: appended in timestamp order, then looked up by a random timestamp.
+template<typename Index>
+void BM_seek_by_timestamp(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Index events;
+    for(std::size_t ts = 0; ts < n; ++ts) {
+        events.emplace(ts * 4, static_cast<int>(ts));
+    }
+    exp::xoshiro256 engine(7);
+    for(auto _ : state) {
+        const std::size_t probe = exp::uniform_int<std::size_t>(engine, 0, n * 4);
+        benchmark::DoNotOptimize(events.lower_bound(probe));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+void BM_seek_by_timestamp_list(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    exp::list<std::pair<std::size_t, int>> events;
+    for(std::size_t ts = 0; ts < n; ++ts) {
+        events.push_back({ts * 4, static_cast<int>(ts)});
+    }
+    exp::xoshiro256 engine(7);
+    for(auto _ : state) {
+        const std::size_t probe = exp::uniform_int<std::size_t>(engine, 0, n * 4);
+        benchmark::DoNotOptimize(std::find_if(events.begin(), events.end(), [probe](const auto& event) { return event.first >= probe; }));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+template<typename Index>
+void BM_ordered_scan(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Index events;
+    for(std::size_t ts = 0; ts < n; ++ts) {
+        events.emplace(ts, static_cast<int>(ts));
+    }
+    for(auto _ : state) {
+        long sum = 0;
+        for(const auto& event : events) {
+            sum += event.second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<std::pair<std::size_t, int>>(state, n);
+}
+
+BENCHMARK_TEMPLATE(BM_seek_by_timestamp, exp::skip_list<std::size_t, int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_seek_by_timestamp, std::multimap<std::size_t, int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_seek_by_timestamp_list)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ordered_scan, exp::skip_list<std::size_t, int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_ordered_scan, std::multimap<std::size_t, int>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// ============= Warm restart ============= //
+
+struct restart_record {
+    std::uint64_t key;
+    std::uint64_t payload[3];
+};
+
+std::filesystem::path restart_file(std::size_t n) {
+    const auto path = std::filesystem::temp_directory_path() / ("exp_restart_" + std::to_string(n) + ".bin");
+    if(!std::filesystem::exists(path)) {
+        exp::list<restart_record> records;
+        for(std::size_t i = 0; i < n; ++i) {
+            records.push_back({i, {i, i, i}});
+        }
+        exp::write_mapped_list(records, path);
+    }
+    return path;
+}
+
+// Open the file and touch every element in place.
+void BM_mapped_open_scan(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto path = restart_file(n);
+    for(auto _ : state) {
+        exp::mapped_list<restart_record> records(path);
+        std::uint64_t sum = 0;
+        for(const auto& record : records) {
+            sum += record.key;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<restart_record>(state, n);
+}
+
+// What startup did before: read every record and push it into a fresh exp::list.
+void BM_rebuild_list_from_file(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto path = restart_file(n);
+    for(auto _ : state) {
+        exp::mapped_list<restart_record> records(path);
+        exp::list<restart_record> rebuilt;
+        for(const auto& record : records) {
+            rebuilt.push_back(record);
+        }
+        benchmark::DoNotOptimize(rebuilt);
+    }
+    set_counters<restart_record>(state, n);
+}
+
+BENCHMARK(BM_mapped_open_scan)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_rebuild_list_from_file)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// ============= Adaptors ============= //
+
+// filter -> transform -> take_while, fused into one pass against staged temporaries.
+void BM_adaptor_pipeline(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto values = random_values<int>(n);
+    for(auto _ : state) {
+        long sum = 0;
+        for(int x : values | exp::views::filter([](int x) { return x % 3 != 0; })
+                           | exp::views::transform([](int x) { return x * 7 + 1; })
+                           | exp::views::take_while([](int x) { return x < 4096; })) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<int>(state, n);
+}
+
+void BM_staged_pipeline(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto values = random_values<int>(n);
+    for(auto _ : state) {
+        std::vector<int> filtered;
+        for(int x : values) {
+            if(x % 3 != 0) {
+                filtered.push_back(x);
+            }
+        }
+        std::vector<int> transformed;
+        transformed.reserve(filtered.size());
+        for(int x : filtered) {
+            transformed.push_back(x * 7 + 1);
+        }
+        long sum = 0;
+        for(int x : transformed) {
+            if(x >= 4096) {
+                break;
+            }
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<int>(state, n);
+}
+
+BENCHMARK(BM_adaptor_pipeline)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_staged_pipeline)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// ============= Cache ============= //
+
+// The textbook LRU: std::list for recency, std::unordered_map from key to list iterator.
+template<typename Key, typename Value>
+class std_lru_cache {
+public:
+    explicit std_lru_cache(std::size_t capacity): capacity_(capacity) {}
+
+    Value* get(const Key& key) {
+        auto it = index_.find(key);
+        if(it == index_.end()) {
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return &it->second->second;
+    }
+
+    void put(const Key& key, const Value& value) {
+        if(entries_.size() == capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+        entries_.emplace_front(key, value);
+        index_.emplace(key, entries_.begin());
+    }
+private:
+    std::size_t capacity_;
+    std::list<std::pair<Key, Value>> entries_;
+    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator> index_;
+};
+
+// Read-through cache of n entries over 2n uniformly requested keys, about half hits.
+template<typename Cache>
+void BM_lru_cache(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Cache cache(n);
+    exp::xoshiro256 engine(11);
+    for(auto _ : state) {
+        const std::size_t key = exp::uniform_int<std::size_t>(engine, 0, 2 * n - 1);
+        if(std::size_t* val = cache.get(key)) {
+            benchmark::DoNotOptimize(*val);
+        } else {
+            cache.put(key, key);
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(BM_lru_cache, exp::lru_cache<std::size_t, std::size_t>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_lru_cache, std_lru_cache<std::size_t, std::size_t>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// ============= FIFO ============= //
+
+// Queue held at a depth of n messages: every step pushes one and pops one.
+template<typename Queue>
+void BM_fifo_queue(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Queue queue;
+    for(std::size_t i = 0; i < n; ++i) {
+        queue.push_back(i);
+    }
+    std::size_t next = n;
+    for(auto _ : state) {
+        queue.push_back(next++);
+        benchmark::DoNotOptimize(*queue.begin());
+        queue.pop_front();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+// Producer and consumer moving batches of 64 messages through a queue of depth n.
+void BM_fifo_bulk(benchmark::State& state) {
+    constexpr std::size_t batch = 64;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    exp::ring_deque<std::size_t> queue;
+    for(std::size_t i = 0; i < n; ++i) {
+        queue.push_back(i);
+    }
+    std::array<std::size_t, batch> in{};
+    std::array<std::size_t, batch> out{};
+    for(auto _ : state) {
+        queue.push_back_n(in);
+        benchmark::DoNotOptimize(queue.pop_front_n(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * batch));
+}
+
+BENCHMARK_TEMPLATE(BM_fifo_queue, exp::ring_deque<std::size_t>)->RangeMultiplier(8)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_fifo_queue, exp::list<std::size_t>)->RangeMultiplier(8)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_fifo_queue, std::deque<std::size_t>)->RangeMultiplier(8)->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_fifo_bulk)->RangeMultiplier(8)->Range(1 << 4, 1 << 16);
+
+#if defined(__cpp_lib_ranges_zip)
+template<typename T, std::size_t... I>
+void std_zip_impl(benchmark::State& state, std::index_sequence<I...>) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::array<std::vector<T>, sizeof...(I)> columns;
+    for(auto& col : columns) {
+        col.assign(n, T(1));
+    }
+    for(auto _ : state) {
+        T sum{};
+        for(const auto& row : std::views::zip(columns[I]...)) {
+            sum += (std::get<I>(row) + ...);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters<T>(state, n * sizeof...(I));
+}
+
+template<typename T, std::size_t Ranges>
+void BM_std_views_zip(benchmark::State& state) {
+    std_zip_impl<T>(state, std::make_index_sequence<Ranges>{});
+}
+
+ZIP_BENCHMARKS(BM_std_views_zip, int);
+ZIP_BENCHMARKS(BM_std_views_zip, double);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace exp {
+
+// Reads a file of trivially copyable T as a sequence of fixed-size chunks with
+// bounded memory. A reader thread fills a ring of reusable buffers ahead of the
+// consumer, so reading the next chunk overlaps with computing on the current one.
+// Memory use is buffers * chunk_elements * sizeof(T) whatever the file size.
+template<typename T>
+class chunk_stream {
+    static_assert(std::is_trivially_copyable_v<T>, "chunk_stream needs a trivially copyable T");
+public:
+    static constexpr std::size_t default_chunk_elements = 1 << 20;
+    // One buffer being consumed, one ready, one being read.
+    static constexpr std::size_t default_buffers = 3;
+
+    explicit chunk_stream(const std::filesystem::path& path, std::size_t chunk_elements = default_chunk_elements, std::size_t buffers = default_buffers):
+        chunk_elements_(std::max<std::size_t>(1, chunk_elements)),
+        sizes_(std::max<std::size_t>(2, buffers))
+    {
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd_ < 0) {
+            throw std::runtime_error("chunk_stream: cannot open '" + path.string() + "': " + std::strerror(errno));
+        }
+        ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        try {
+            buffers_.reserve(sizes_.size());
+            for(std::size_t i = 0; i < sizes_.size(); ++i) {
+                buffers_.push_back(std::make_unique_for_overwrite<T[]>(chunk_elements_));
+            }
+            reader_ = std::thread([this]() { readLoop(); });
+        } catch(...) {
+            ::close(fd_);
+            throw;
+        }
+    }
+
+    chunk_stream(const chunk_stream&) = delete;
+    chunk_stream& operator=(const chunk_stream&) = delete;
+
+    // Stops the read-ahead even if the file was not consumed to the end.
+    ~chunk_stream() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        reader_.join();
+        ::close(fd_);
+    }
+
+    // Next chunk in file order, empty once the file is exhausted. The span stays
+    // valid until the following call, which hands its buffer back to the reader.
+    // A read error is rethrown here after the chunks read before it.
+    std::span<const T> next() {
+        std::unique_lock lock(mutex_);
+        if(holding_) {
+            ++consumed_;
+            holding_ = false;
+            cv_.notify_all();
+        }
+        cv_.wait(lock, [this]() { return produced_ > consumed_ || finished_; });
+        if(produced_ > consumed_) {
+            holding_ = true;
+            const std::size_t slot = consumed_ % buffers_.size();
+            return {buffers_[slot].get(), sizes_[slot]};
+        }
+        if(error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+        return {};
+    }
+
+    std::size_t chunk_elements() const noexcept { return chunk_elements_; }
+    std::size_t buffer_count() const noexcept { return buffers_.size(); }
+
+private:
+    void readLoop() noexcept {
+        try {
+            for(;;) {
+                std::size_t slot{};
+                {
+                    std::unique_lock lock(mutex_);
+                    cv_.wait(lock, [this]() { return stop_ || produced_ - consumed_ < buffers_.size(); });
+                    if(stop_) {
+                        break;
+                    }
+                    slot = produced_ % buffers_.size();
+                }
+
+                const std::size_t count = fill(buffers_[slot].get());
+                if(count != 0) {
+                    std::lock_guard lock(mutex_);
+                    sizes_[slot] = count;
+                    ++produced_;
+                }
+                cv_.notify_all();
+                if(count < chunk_elements_) {
+                    break;
+                }
+            }
+        } catch(...) {
+            std::lock_guard lock(mutex_);
+            error_ = std::current_exception();
+        }
+        {
+            std::lock_guard lock(mutex_);
+            finished_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    // Reads up to one chunk, fewer elements only at the end of the file.
+    std::size_t fill(T* buffer) {
+        auto* bytes = reinterpret_cast<char*>(buffer);
+        const std::size_t capacity = chunk_elements_ * sizeof(T);
+        std::size_t done = 0;
+        while(done < capacity) {
+            const ::ssize_t got = ::read(fd_, bytes + done, capacity - done);
+            if(got < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error(std::string("chunk_stream: read failed: ") + std::strerror(errno));
+            }
+            if(got == 0) {
+                break;
+            }
+            done += static_cast<std::size_t>(got);
+        }
+        if(done % sizeof(T) != 0) {
+            throw std::runtime_error("chunk_stream: file size is not a multiple of the element size");
+        }
+        return done / sizeof(T);
+    }
+
+    std::size_t chunk_elements_;
+    std::vector<std::size_t> sizes_;
+    std::vector<std::unique_ptr<T[]>> buffers_;
+    int fd_ = -1;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::uint64_t produced_{};
+    std::uint64_t consumed_{};
+    bool holding_ = false;
+    bool finished_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::thread reader_;
+};
+
+// Count, sum, min and max of a stream, combined chunk by chunk.
+template<typename T, typename Sum = double>
+class running_stats {
+public:
+    void operator()(std::span<const T> chunk) noexcept {
+        for(const T& value : chunk) {
+            sum_ += static_cast<Sum>(value);
+            min_ = std::min(min_, value);
+            max_ = std::max(max_, value);
+        }
+        count_ += chunk.size();
+    }
+
+    std::uint64_t count() const noexcept { return count_; }
+    Sum sum() const noexcept { return sum_; }
+    double mean() const noexcept { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+    T min() const noexcept { return min_; }
+    T max() const noexcept { return max_; }
+
+private:
+    std::uint64_t count_{};
+    Sum sum_{};
+    T min_ = std::numeric_limits<T>::max();
+    T max_ = std::numeric_limits<T>::lowest();
+};
+
+// Feeds every chunk of stream to each stage in turn, stage(std::span<const T>).
+// Returns the number of elements consumed.
+template<typename T, typename... Stages>
+std::uint64_t stream_reduce(chunk_stream<T>& stream, Stages&... stages) {
+    std::uint64_t elements = 0;
+    for(auto chunk = stream.next(); !chunk.empty(); chunk = stream.next()) {
+        (stages(chunk), ...);
+        elements += chunk.size();
+    }
+    return elements;
+}
+
+} // namespace exp
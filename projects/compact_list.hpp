@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "iterator.hpp"
+#include "allocation_stats.hpp"
+
+namespace exp {
+
+// Doubly linked list for large counts of small elements. Nodes are slots of one
+// contiguous slab linked by Index instead of pointers, so an int node takes 12
+// bytes against 24 plus a heap block header for exp::list, and a step costs a
+// single load like a pointer hop. Erased nodes go to a free stack threaded
+// through next_ and are reused before the slab grows. Slot 0 is the sentinel.
+// Growing the slab relocates the elements: like std::vector it invalidates
+// references, but iterators hold (list, index) and stay valid until their
+// element is erased or the list object itself is moved. reserve() avoids it.
+template<typename T, typename Allocator = default_allocator<T>, typename Index = std::uint32_t>
+class compact_list {
+	static_assert(std::is_unsigned_v<Index>, "compact_list links must be an unsigned integer type");
+public:
+	static constexpr std::size_t min_slots = 16;
+	// Index 0 is taken by the sentinel.
+	static constexpr std::size_t max_nodes = static_cast<std::size_t>(std::numeric_limits<Index>::max());
+
+	class Node {
+		friend compact_list;
+	public:
+		using payload_type = T;
+
+		Node() noexcept {}
+		// Trivial when T is, so the slab of a trivially copyable T grows by memcpy.
+		~Node() requires std::is_trivially_destructible_v<T> = default;
+		~Node() {}
+	private:
+		Index next_;
+		Index prev_;
+		union {
+			T value_;
+		};
+	};
+
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using index_type = Index;
+
+	// ============= Iterator ============= //
+
+	template<bool isConst>
+	class compact_iterator: public iterator_facade<compact_iterator<isConst>, std::conditional_t<isConst, const T, T>, std::bidirectional_iterator_tag> {
+		using BaseType = iterator_facade<compact_iterator<isConst>, std::conditional_t<isConst, const T, T>, std::bidirectional_iterator_tag>;
+		friend compact_list;
+	public:
+		using value_type = typename BaseType::value_type;
+		using reference = typename BaseType::reference;
+		using iterator_category = typename BaseType::iterator_category;
+		using difference_type = typename BaseType::difference_type;
+
+		using owner_pointer = std::conditional_t<isConst, const compact_list*, compact_list*>;
+
+		compact_iterator() noexcept = default;
+		compact_iterator(owner_pointer owner, Index index) noexcept: owner_(owner), index_(index) {}
+
+		template<bool wasConst> requires (isConst && !wasConst)
+		compact_iterator(const compact_iterator<wasConst>& other) noexcept: owner_(other.owner_), index_(other.index_) {}
+
+		reference dereference() const noexcept { return owner_->node(index_).value_; }
+		void increment() noexcept { index_ = owner_->node(index_).next_; }
+		void decrement() noexcept { index_ = owner_->node(index_).prev_; }
+
+		bool equal(const compact_iterator& rhs) const noexcept { return index_ == rhs.index_; }
+	private:
+		template<bool> friend class compact_iterator;
+
+		owner_pointer owner_ = nullptr;
+		Index index_{};
+	};
+
+	// ==================================== //
+
+	using iterator = compact_iterator<false>;
+	using const_iterator = compact_iterator<true>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	iterator begin() noexcept { return iterator(this, nodes_ ? nodes_[0].next_ : Index{0}); }
+	const_iterator begin() const noexcept { return cbegin(); }
+	const_iterator cbegin() const noexcept { return const_iterator(this, nodes_ ? nodes_[0].next_ : Index{0}); }
+
+	iterator end() noexcept { return iterator(this, 0); }
+	const_iterator end() const noexcept { return cend(); }
+	const_iterator cend() const noexcept { return const_iterator(this, 0); }
+
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+	compact_list(): compact_list(Allocator()) {}
+
+	explicit compact_list(const Allocator& alloc): alloc_(alloc) {}
+
+	compact_list(std::initializer_list<T> init_list): compact_list() {
+		append(init_list.begin(), init_list.end());
+	}
+
+	template<std::input_iterator It>
+	compact_list(It first, It last): compact_list() {
+		append(first, last);
+	}
+
+	// The copy is laid out in list order, whatever the order of the source slots.
+	compact_list(const compact_list& other): compact_list(Allocator(node_traits::select_on_container_copy_construction(other.alloc_))) {
+		reserve(other.size_);
+		append(other.begin(), other.end());
+	}
+
+	compact_list(compact_list&& other) noexcept:
+		nodes_(std::exchange(other.nodes_, nullptr)),
+		slots_(std::exchange(other.slots_, 0)),
+		used_(std::exchange(other.used_, 0)),
+		free_head_(std::exchange(other.free_head_, 0)),
+		size_(std::exchange(other.size_, 0)),
+		alloc_(other.alloc_) {}
+
+	compact_list& operator=(compact_list other) noexcept {
+		swap(other);
+		return *this;
+	}
+
+	~compact_list() {
+		clear();
+		if(nodes_) {
+			node_traits::deallocate(alloc_, nodes_, slots_);
+		}
+	}
+
+	void swap(compact_list& other) noexcept {
+		using std::swap;
+		swap(nodes_, other.nodes_);
+		swap(slots_, other.slots_);
+		swap(used_, other.used_);
+		swap(free_head_, other.free_head_);
+		swap(size_, other.size_);
+		swap(alloc_, other.alloc_);
+	}
+
+	friend void swap(compact_list& lhs, compact_list& rhs) noexcept { lhs.swap(rhs); }
+
+	size_type size() const noexcept { return size_; }
+	bool empty() const noexcept { return size_ == 0; }
+	static constexpr size_type max_size() noexcept { return max_nodes; }
+
+	// Elements that fit without growing the slab.
+	size_type capacity() const noexcept { return slots_ ? slots_ - 1 : 0; }
+
+	void reserve(size_type count) {
+		if(count > max_nodes) {
+			throw std::runtime_error("compact_list: reserve exceeds the index range");
+		}
+		if(count > capacity()) {
+			grow(count + 1);
+		}
+	}
+
+	allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+	T& front() noexcept { return *begin(); }
+	const T& front() const noexcept { return *begin(); }
+	T& back() noexcept { return *std::prev(end()); }
+	const T& back() const noexcept { return *std::prev(end()); }
+
+	template<typename... Args>
+	iterator emplace(iterator pos, Args&&... args) {
+		const Index idx = createNode(std::forward<Args>(args)...);
+		linkBefore(idx, pos.index_);
+		return iterator(this, idx);
+	}
+
+	iterator insert(iterator pos, const T& val) { return emplace(pos, val); }
+	iterator insert(iterator pos, T&& val) { return emplace(pos, std::move(val)); }
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args) { return *emplace(end(), std::forward<Args>(args)...); }
+
+	template<typename... Args>
+	T& emplace_front(Args&&... args) { return *emplace(begin(), std::forward<Args>(args)...); }
+
+	void push_back(const T& val) { emplace_back(val); }
+	void push_back(T&& val) { emplace_back(std::move(val)); }
+
+	void push_front(const T& val) { emplace_front(val); }
+	void push_front(T&& val) { emplace_front(std::move(val)); }
+
+	template<std::input_iterator It>
+	void append(It first, It last) {
+		if constexpr (std::forward_iterator<It>) {
+			reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+		}
+		for(; first != last; ++first) {
+			emplace_back(*first);
+		}
+	}
+
+	iterator erase(iterator pos) noexcept {
+		Node& curr = node(pos.index_);
+		const Index next = curr.next_;
+		node(curr.prev_).next_ = next;
+		node(next).prev_ = curr.prev_;
+		destroyNode(pos.index_);
+		return iterator(this, next);
+	}
+
+	void pop_back() noexcept { erase(std::prev(end())); }
+	void pop_front() noexcept { erase(begin()); }
+
+	// Destroys every element, the slab is kept for reuse.
+	void clear() noexcept {
+		if(!nodes_) {
+			return;
+		}
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for(Index idx = node(0).next_; idx != 0; idx = node(idx).next_) {
+				std::destroy_at(&node(idx).value_);
+			}
+		}
+		node(0).next_ = 0;
+		node(0).prev_ = 0;
+		used_ = 1;
+		free_head_ = 0;
+		size_ = 0;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const compact_list& list) {
+		for(const auto& el : list) {
+			os << el << ' ';
+		}
+		return os;
+	}
+
+	friend bool operator==(const compact_list& rhs, const compact_list& lhs) noexcept {
+		return rhs.size() == lhs.size() && std::equal(rhs.begin(), rhs.end(), lhs.begin());
+	}
+	friend bool operator!=(const compact_list& rhs, const compact_list& lhs) noexcept {
+		return !(rhs == lhs);
+	}
+
+private:
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+
+	Node& node(Index idx) noexcept { return nodes_[idx]; }
+	const Node& node(Index idx) const noexcept { return nodes_[idx]; }
+
+	// Moves the slab to a block of at least min_count slots. It grows by half, not
+	// double, to keep the unused tail small for very long lists.
+	void grow(std::size_t min_count) {
+		const std::size_t limit = max_nodes < std::numeric_limits<std::size_t>::max() ? max_nodes + 1 : max_nodes;
+		std::size_t count = std::max(min_slots, slots_ + slots_ / 2);
+		count = std::min(std::max(count, min_count), limit);
+		if(count <= slots_) {
+			throw std::runtime_error("compact_list: index range exhausted");
+		}
+
+		Node* fresh = node_traits::allocate(alloc_, count);
+		if(!nodes_) {
+			Node* sentinel = std::construct_at(fresh);
+			sentinel->next_ = 0;
+			sentinel->prev_ = 0;
+			used_ = 1;
+		} else if constexpr (std::is_trivially_copyable_v<Node>) {
+			std::memcpy(static_cast<void*>(fresh), nodes_, used_ * sizeof(Node));
+		} else {
+			// Links are copied for every slot, values only for the live nodes.
+			for(std::size_t idx = 0; idx < used_; ++idx) {
+				Node* slot = std::construct_at(fresh + idx);
+				slot->next_ = nodes_[idx].next_;
+				slot->prev_ = nodes_[idx].prev_;
+			}
+			Index idx = nodes_[0].next_;
+			try {
+				for(; idx != 0; idx = nodes_[idx].next_) {
+					std::construct_at(&fresh[idx].value_, std::move_if_noexcept(nodes_[idx].value_));
+				}
+			} catch(...) {
+				for(Index done = nodes_[0].next_; done != idx; done = nodes_[done].next_) {
+					std::destroy_at(&fresh[done].value_);
+				}
+				node_traits::deallocate(alloc_, fresh, count);
+				throw;
+			}
+			for(idx = nodes_[0].next_; idx != 0; idx = nodes_[idx].next_) {
+				std::destroy_at(&nodes_[idx].value_);
+			}
+		}
+		if(nodes_) {
+			node_traits::deallocate(alloc_, nodes_, slots_);
+		}
+		nodes_ = fresh;
+		slots_ = count;
+	}
+
+	// Slot from the free stack, else the next never used one.
+	Index acquireNode() {
+		if(free_head_ != 0) {
+			return std::exchange(free_head_, node(free_head_).next_);
+		}
+		if(used_ == slots_) {
+			grow(used_ + 1);
+		}
+		const auto idx = static_cast<Index>(used_++);
+		std::construct_at(nodes_ + idx);
+		return idx;
+	}
+
+	void releaseNode(Index idx) noexcept {
+		node(idx).next_ = free_head_;
+		free_head_ = idx;
+	}
+
+	template<typename... Args>
+	Index createNode(Args&&... args) {
+		if(free_head_ == 0 && used_ == slots_ && size_ != 0) {
+			// args may refer to an element, which growing the slab relocates.
+			T value(std::forward<Args>(args)...);
+			return constructNode(acquireNode(), std::move(value));
+		}
+		return constructNode(acquireNode(), std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	Index constructNode(Index idx, Args&&... args) {
+		try {
+			std::construct_at(&node(idx).value_, std::forward<Args>(args)...);
+		} catch(...) {
+			releaseNode(idx);
+			throw;
+		}
+		++size_;
+		return idx;
+	}
+
+	void destroyNode(Index idx) noexcept {
+		std::destroy_at(&node(idx).value_);
+		releaseNode(idx);
+		--size_;
+	}
+
+	void linkBefore(Index idx, Index curr) noexcept {
+		Node& new_node = node(idx);
+		Node& next = node(curr);
+		new_node.next_ = curr;
+		new_node.prev_ = next.prev_;
+		node(next.prev_).next_ = idx;
+		next.prev_ = idx;
+	}
+
+	Node* nodes_ = nullptr;
+	std::size_t slots_{};
+	std::size_t used_{};
+	Index free_head_{};
+	size_type size_{};
+	[[no_unique_address]] node_allocator alloc_;
+};
+
+template<typename T>
+compact_list(std::initializer_list<T>) -> compact_list<T>;
+
+template<std::input_iterator It>
+compact_list(It, It) -> compact_list<typename std::iterator_traits<It>::value_type>;
+
+} // namespace exp
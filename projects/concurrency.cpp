@@ -4,29 +4,405 @@
 #include <vector>
 #include <atomic>
 #include <queue>
-#include <random>
+#include <string_view>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <unordered_map>
 #include "details.hpp"
+#include "parallel_reduce.hpp"
+#include "parallel_algorithms.hpp"
+#include "list.hpp"
+#include "concurrent_list.hpp"
+#include "concurrent_hash_map.hpp"
+#include "instrumentation.hpp"
+#include "chunk_stream.hpp"
 #include <numeric>
 
-std::vector<int> makeRandomVector(size_t size) {
-    std::random_device rnd_device;
-    std::mt19937 mersenne_engine {rnd_device()};
-    std::uniform_int_distribution<int> dist {1, static_cast<int>(size)};
-
-    auto random_gen = [&](){return dist(mersenne_engine);};
+std::vector<int> makeRandomVector(exp::chunked_thread_pool& pool, size_t size, std::uint64_t seed) {
     std::vector<int> ret(size);
-    std::generate(std::begin(ret), std::end(ret), random_gen);
+    exp::parallel_generate(pool, ret.begin(), ret.end(), seed, [size](exp::xoshiro256& engine) {
+        return exp::uniform_int(engine, 1, static_cast<int>(size));
+    });
     return ret;
 }
 
-int main() {
-    auto random_vector = makeRandomVector(1e8);
-    
-    auto mean_proc = [](const std::vector<int>& vec) {
-        return std::accumulate(std::begin(vec), std::end(vec), 0.0) / vec.size();
-    };
+double parallelMean(exp::chunked_thread_pool& pool, const std::vector<int>& vec) {
+    auto sum = exp::parallel_transform_reduce(pool, vec.begin(), vec.end(), std::int64_t{0}, std::plus<>{},
+        [](int val) { return static_cast<std::int64_t>(val); });
+    return static_cast<double>(sum) / vec.size();
+}
+
+std::uint64_t timeSeed() {
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+void runMean() {
+    exp::chunked_thread_pool pool;
+    auto random_vector = makeRandomVector(pool, 1e8, timeSeed());
 
-    auto res = details::time_execution(mean_proc, random_vector);
+    exp::instrumentation::latency_histogram mean_hist;
+    double res{};
+    {
+        exp::instrumentation::scoped_timer timer("mean", &mean_hist);
+        res = parallelMean(pool, random_vector);
+    }
 
+    mean_hist.write_summary(std::cout, "mean");
     std::cout << res << std::endl;
-}
\ No newline at end of file
+}
+
+// ============= Scaling ============= //
+
+template<typename F>
+double bestOfSeconds(size_t repeats, F&& func) {
+    double best = std::numeric_limits<double>::max();
+    for(size_t i = 0; i < repeats; ++i) {
+        auto begin = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// Powers of two up to hardware_concurrency, plus hardware_concurrency itself.
+std::vector<size_t> threadCounts() {
+    const size_t max_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    std::vector<size_t> counts;
+    for(size_t threads = 1; threads < max_threads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(max_threads);
+    return counts;
+}
+
+// Generation and mean over size elements with 1..hardware_concurrency threads.
+void runScaling(size_t size) {
+    std::vector<int> vec(size);
+    double base_generate = 0;
+    double base_reduce = 0;
+
+    std::cout << "threads | generate s (speedup) | mean s (speedup) GB/s" << std::endl;
+    for(size_t threads : threadCounts()) {
+        exp::chunked_thread_pool pool(threads);
+        double generate = bestOfSeconds(3, [&]() {
+            exp::parallel_generate(pool, vec.begin(), vec.end(), 42, [size](exp::xoshiro256& engine) {
+                return exp::uniform_int(engine, 1, static_cast<int>(size));
+            });
+        });
+        double mean{};
+        double reduce = bestOfSeconds(5, [&]() { mean = parallelMean(pool, vec); });
+        if(threads == 1) {
+            base_generate = generate;
+            base_reduce = reduce;
+        }
+        std::cout << threads << " | " << generate << " (" << base_generate / generate << ") | "
+                  << reduce << " (" << base_reduce / reduce << ") "
+                  << size * sizeof(int) / reduce / 1e9 << "  mean=" << mean << std::endl;
+    }
+}
+
+// exp::parallel algorithms over an exp::list and a zip of two vectors with
+// 1..hardware_concurrency workers.
+void runAlgorithmScaling(size_t size) {
+    exp::list<int> list;
+    std::vector<int> values(size);
+    std::vector<float> weights(size, 0.5f);
+    for(size_t idx = 0; idx < size; ++idx) {
+        values[idx] = static_cast<int>(idx % 1000);
+        list.push_back(values[idx]);
+    }
+    auto zip = make_zip_range(values, weights);
+
+    double base_list = 0;
+    double base_count = 0;
+    double base_zip = 0;
+    std::cout << "threads | list reduce s (speedup) | list count_if s (speedup) | zip for_each s (speedup)" << std::endl;
+    for(size_t threads : threadCounts()) {
+        exp::work_stealing_pool pool(threads);
+        long long sum{};
+        size_t count{};
+        double list_reduce = bestOfSeconds(5, [&]() { sum = exp::parallel::reduce(pool, list, 0LL); });
+        double list_count = bestOfSeconds(5, [&]() {
+            count = exp::parallel::count_if(pool, list, [](int val) { return val % 7 == 0; });
+        });
+        double zip_for_each = bestOfSeconds(5, [&]() {
+            exp::parallel::for_each(pool, zip, [](auto row) { std::get<1>(row) = static_cast<float>(std::get<0>(row)) * 0.5f; });
+        });
+        if(threads == 1) {
+            base_list = list_reduce;
+            base_count = list_count;
+            base_zip = zip_for_each;
+        }
+        std::cout << threads << " | " << list_reduce << " (" << base_list / list_reduce << ") | "
+                  << list_count << " (" << base_count / list_count << ") | "
+                  << zip_for_each << " (" << base_zip / zip_for_each << ")  sum=" << sum << " count=" << count << std::endl;
+    }
+}
+
+// ============= Streaming ============= //
+
+// Writes size random ints to path one chunk at a time, memory stays at one chunk.
+void writeRandomFile(exp::chunked_thread_pool& pool, const std::filesystem::path& path, size_t size, std::uint64_t seed) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    std::vector<int> chunk(exp::chunk_stream<int>::default_chunk_elements);
+    for(size_t written = 0, round = 0; written < size; written += chunk.size(), ++round) {
+        chunk.resize(std::min(chunk.size(), size - written));
+        exp::parallel_generate(pool, chunk.begin(), chunk.end(), seed + round, [size](exp::xoshiro256& engine) {
+            return exp::uniform_int(engine, 1, static_cast<int>(size));
+        });
+        out.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size() * sizeof(int)));
+    }
+    if(!out) {
+        throw std::runtime_error("cannot write " + path.string());
+    }
+}
+
+// Mean and min/max of a file of ints with bounded memory: the reader thread fills
+// the next buffer while the pool reduces the current one.
+void runStream(size_t size, const std::filesystem::path& path) {
+    exp::chunked_thread_pool pool;
+    if(!std::filesystem::exists(path) || std::filesystem::file_size(path) != size * sizeof(int)) {
+        writeRandomFile(pool, path, size, timeSeed());
+    }
+
+    std::int64_t sum{};
+    exp::running_stats<int, std::int64_t> stats;
+    auto parallel_sum = [&](std::span<const int> chunk) {
+        sum += exp::parallel_reduce(pool, chunk.begin(), chunk.end(), std::int64_t{0});
+    };
+
+    auto begin = std::chrono::steady_clock::now();
+    exp::chunk_stream<int> stream(path);
+    const auto elements = exp::stream_reduce(stream, parallel_sum, stats);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    std::cout << "elements " << elements << " mean " << static_cast<double>(sum) / static_cast<double>(elements)
+              << " min " << stats.min() << " max " << stats.max() << '\n'
+              << elapsed.count() << " s, " << elements * sizeof(int) / elapsed.count() / 1e9 << " GB/s, buffers "
+              << stream.buffer_count() * stream.chunk_elements() * sizeof(int) / (1 << 20) << " MiB" << std::endl;
+}
+
+// ============= Trace ============= //
+
+// Repeats generation and mean under scoped timers, prints latency percentiles and
+// writes a Chrome trace of every round.
+void runTrace(const std::string& path) {
+    using namespace exp::instrumentation;
+    constexpr size_t rounds = 20;
+    constexpr size_t size = 10'000'000;
+
+    tsc_clock::calibrate();
+    exp::chunked_thread_pool pool;
+    std::vector<int> vec(size);
+    latency_histogram generate_hist;
+    latency_histogram mean_hist;
+    double mean{};
+
+    for(size_t round = 0; round < rounds; ++round) {
+        scoped_timer round_timer("round");
+        {
+            scoped_timer timer("generate", &generate_hist);
+            exp::parallel_generate(pool, vec.begin(), vec.end(), round, [](exp::xoshiro256& engine) {
+                return exp::uniform_int(engine, 1, static_cast<int>(size));
+            });
+        }
+        scoped_timer timer("mean", &mean_hist);
+        mean = parallelMean(pool, vec);
+    }
+
+    generate_hist.write_summary(std::cout, "generate");
+    mean_hist.write_summary(std::cout, "mean");
+    std::cout << "mean=" << mean << ", " << write_chrome_trace(path) << " events written to " << path << std::endl;
+}
+
+// ============= Queue throughput ============= //
+
+template<typename T>
+class mutex_list {
+public:
+    void push(const T& val) {
+        std::lock_guard lock(mutex_);
+        list_.push_back(val);
+    }
+
+    std::optional<T> try_pop() {
+        std::lock_guard lock(mutex_);
+        if(list_.size() == 0) {
+            return std::nullopt;
+        }
+        T val = *list_.begin();
+        list_.pop_front();
+        return val;
+    }
+private:
+    std::mutex mutex_;
+    exp::list<T> list_;
+};
+
+struct lock_free_list_adapter {
+    void push(int val) { list_.push_front(val); }
+    std::optional<int> try_pop() { return list_.try_pop_front(); }
+
+    exp::lock_free_list<int> list_;
+};
+
+// Every producer pushes items_per_producer values, consumers drain until all of them are popped.
+template<typename Queue>
+double queueThroughput(size_t producers, size_t consumers, size_t items_per_producer) {
+    Queue queue;
+    const size_t total = producers * items_per_producer;
+    std::atomic<size_t> consumed{0};
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+
+    for(size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            while(!start.load(std::memory_order_acquire)) {}
+            for(size_t i = 0; i < items_per_producer; ++i) {
+                queue.push(static_cast<int>(i));
+            }
+        });
+    }
+    for(size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            while(!start.load(std::memory_order_acquire)) {}
+            while(consumed.load(std::memory_order_relaxed) < total) {
+                if(queue.try_pop()) {
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    return total / elapsed.count() / 1e6;
+}
+
+void runQueue() {
+    constexpr size_t items_per_producer = 1'000'000;
+    const size_t max_threads = std::max<size_t>(2, std::thread::hardware_concurrency());
+
+    std::cout << "producers consumers | concurrent_queue lock_free_list mutex+exp::list (Mops/s)" << std::endl;
+    for(size_t threads = 1; threads * 2 <= max_threads || threads == 1; threads *= 2) {
+        std::cout << threads << ' ' << threads << " | "
+                  << queueThroughput<exp::concurrent_queue<int>>(threads, threads, items_per_producer) << ' '
+                  << queueThroughput<lock_free_list_adapter>(threads, threads, items_per_producer) << ' '
+                  << queueThroughput<mutex_list<int>>(threads, threads, items_per_producer) << std::endl;
+    }
+}
+
+// ============= Hash map throughput ============= //
+
+// The setup the sharded map replaces: one std::unordered_map behind one mutex.
+class locked_unordered_map {
+public:
+    std::optional<int> find(int key) const {
+        std::lock_guard lock(mutex_);
+        auto it = map_.find(key);
+        return it == map_.end() ? std::nullopt : std::optional<int>(it->second);
+    }
+
+    bool insert_or_assign(int key, int val) {
+        std::lock_guard lock(mutex_);
+        return map_.insert_or_assign(key, val).second;
+    }
+
+    bool erase(int key) {
+        std::lock_guard lock(mutex_);
+        return map_.erase(key) != 0;
+    }
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<int, int> map_;
+};
+
+// Every thread runs ops_per_thread operations on random keys in [0, keys): reads
+// with probability read_percent, otherwise an insert_or_assign or erase. Half the
+// keys are present at the start.
+template<typename Map>
+double hashMapThroughput(size_t threads, size_t ops_per_thread, int keys, int read_percent) {
+    Map map;
+    for(int key = 0; key < keys; key += 2) {
+        map.insert_or_assign(key, key);
+    }
+    std::atomic<bool> start{false};
+    std::atomic<size_t> hits{0};
+    std::vector<std::thread> workers;
+
+    for(size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            exp::xoshiro256 engine(t + 1);
+            size_t local_hits = 0;
+            while(!start.load(std::memory_order_acquire)) {}
+            for(size_t i = 0; i < ops_per_thread; ++i) {
+                const int key = exp::uniform_int(engine, 0, keys - 1);
+                const int dice = exp::uniform_int(engine, 0, 99);
+                if(dice < read_percent) {
+                    local_hits += map.find(key).has_value();
+                } else if(dice % 2 == 0) {
+                    map.insert_or_assign(key, key);
+                } else {
+                    map.erase(key);
+                }
+            }
+            hits.fetch_add(local_hits, std::memory_order_relaxed);
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for(auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    return threads * ops_per_thread / elapsed.count() / 1e6;
+}
+
+void runHashMap(int keys) {
+    constexpr size_t ops_per_thread = 1'000'000;
+    using sharded_map = exp::concurrent_hash_map<int, int>;
+
+    std::cout << "threads | read-heavy 90% sharded mutex | write-heavy 10% sharded mutex (Mops/s)" << std::endl;
+    for(size_t threads : threadCounts()) {
+        std::cout << threads << " | "
+                  << hashMapThroughput<sharded_map>(threads, ops_per_thread, keys, 90) << ' '
+                  << hashMapThroughput<locked_unordered_map>(threads, ops_per_thread, keys, 90) << " | "
+                  << hashMapThroughput<sharded_map>(threads, ops_per_thread, keys, 10) << ' '
+                  << hashMapThroughput<locked_unordered_map>(threads, ops_per_thread, keys, 10) << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string_view mode = argc > 1 ? argv[1] : "mean";
+
+    if(mode == "mean") {
+        runMean();
+    } else if(mode == "queue") {
+        runQueue();
+    } else if(mode == "scaling") {
+        runScaling(argc > 2 ? std::stoull(argv[2]) : 100'000'000);
+    } else if(mode == "algorithms") {
+        runAlgorithmScaling(argc > 2 ? std::stoull(argv[2]) : 10'000'000);
+    } else if(mode == "stream") {
+        runStream(argc > 2 ? std::stoull(argv[2]) : 100'000'000, argc > 3 ? argv[3] : "stream.bin");
+    } else if(mode == "hashmap") {
+        runHashMap(argc > 2 ? std::stoi(argv[2]) : 1'000'000);
+    } else if(mode == "trace") {
+        runTrace(argc > 2 ? argv[2] : "trace.json");
+    } else {
+        std::cout << "Usage: concurrency [mean|queue|scaling [size]|algorithms [size]|stream [size] [file]|hashmap [keys]|trace [file]]" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include "list_hook.hpp"
+#include "prng.hpp"
+
+namespace exp {
+
+// Hash map safe for concurrent use, split into independently locked shards.
+// Readers of a shard share its std::shared_mutex, writers take it exclusively,
+// so operations on different shards never contend. Each bucket is a circular
+// chain of list_hook links, the same layout exp::list nodes use.
+//
+// A shard grows by allocating a table twice the size and then moving a few old
+// buckets into it on every later write, so no single operation pays for a full
+// rehash. Until an old bucket is drained, lookups check it as well.
+//
+// Values are returned by copy or visited under the shard lock; references into
+// the map are never handed out since another thread may erase the entry.
+template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class concurrent_hash_map {
+public:
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = std::pair<const Key, T>;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+
+	static constexpr std::size_t default_shards = 64;
+
+	explicit concurrent_hash_map(std::size_t shards = default_shards, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual()):
+		shard_count_(std::bit_ceil(std::max<std::size_t>(1, shards))),
+		shard_shift_(64 - std::countr_zero(shard_count_)),
+		shards_(std::make_unique<Shard[]>(shard_count_)),
+		hash_(hash),
+		equal_(equal)
+	{}
+
+	concurrent_hash_map(const concurrent_hash_map&) = delete;
+	concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+
+	// Must not race with other operations.
+	~concurrent_hash_map() {
+		for(std::size_t idx = 0; idx < shard_count_; ++idx) {
+			shards_[idx].destroyNodes();
+		}
+	}
+
+	// ============= Modifiers ============= //
+
+	// Returns false and leaves the map unchanged if key is already present.
+	bool insert(const Key& key, const T& value) { return emplace(key, value); }
+	bool insert(Key&& key, T&& value) { return emplace(std::move(key), std::move(value)); }
+
+	// The node is built before the shard is locked, so a constructor never runs
+	// inside the critical section; it is thrown away if the key exists.
+	template<typename... Args>
+	bool emplace(Args&&... args) {
+		std::unique_ptr<Node> node(new Node(std::forward<Args>(args)...));
+		node->hash_ = hashOf(node->value_.first);
+		Shard& shard = shardOf(node->hash_);
+
+		std::unique_lock lock(shard.mutex_);
+		shard.migrate(migrate_step);
+		if(findNode(shard, node->hash_, node->value_.first)) {
+			lock.unlock();
+			return false;
+		}
+		shard.link(node.get());
+		node.release();
+		return true;
+	}
+
+	// Returns true if the key was inserted, false if an existing value was overwritten.
+	// Like emplace(), the node is built before the lock; on a hit only its value is
+	// moved into the existing node, and the node is freed after the unlock.
+	template<typename V>
+	bool insert_or_assign(const Key& key, V&& value) {
+		std::unique_ptr<Node> node(new Node(key, std::forward<V>(value)));
+		node->hash_ = hashOf(key);
+		Shard& shard = shardOf(node->hash_);
+
+		std::unique_lock lock(shard.mutex_);
+		shard.migrate(migrate_step);
+		if(Node* found = findNode(shard, node->hash_, key)) {
+			found->value_.second = std::move(node->value_.second);
+			lock.unlock();
+			return false;
+		}
+		shard.link(node.get());
+		node.release();
+		return true;
+	}
+
+	bool erase(const Key& key) {
+		const std::size_t hash = hashOf(key);
+		Shard& shard = shardOf(hash);
+		std::unique_ptr<Node> node;
+		{
+			std::unique_lock lock(shard.mutex_);
+			shard.migrate(migrate_step);
+			node.reset(findNode(shard, hash, key));
+			if(!node) {
+				return false;
+			}
+			shard.unlink(node.get());
+		}
+		return true;
+	}
+
+	// Calls func(T&) on the value under the exclusive shard lock.
+	template<typename F>
+	bool update(const Key& key, F&& func) {
+		const std::size_t hash = hashOf(key);
+		Shard& shard = shardOf(hash);
+		std::unique_lock lock(shard.mutex_);
+		shard.migrate(migrate_step);
+		Node* found = findNode(shard, hash, key);
+		if(!found) {
+			return false;
+		}
+		std::invoke(std::forward<F>(func), found->value_.second);
+		return true;
+	}
+
+	// Keeps the bucket tables. Shards are cleared one at a time, so concurrent
+	// inserts into an already cleared shard survive.
+	void clear() {
+		for(std::size_t idx = 0; idx < shard_count_; ++idx) {
+			std::unique_lock lock(shards_[idx].mutex_);
+			shards_[idx].destroyNodes();
+		}
+	}
+
+	// ============= Lookup ============= //
+
+	std::optional<T> find(const Key& key) const {
+		std::optional<T> ret;
+		visit(key, [&ret](const T& value) { ret.emplace(value); });
+		return ret;
+	}
+
+	bool contains(const Key& key) const {
+		return visit(key, [](const T&) {});
+	}
+
+	// Calls func(const T&) on the value under the shared shard lock.
+	template<typename F>
+	bool visit(const Key& key, F&& func) const {
+		const std::size_t hash = hashOf(key);
+		const Shard& shard = shardOf(hash);
+		std::shared_lock lock(shard.mutex_);
+		const Node* found = findNode(shard, hash, key);
+		if(!found) {
+			return false;
+		}
+		std::invoke(std::forward<F>(func), std::as_const(found->value_.second));
+		return true;
+	}
+
+	// Calls func(const value_type&) on every entry, one shard at a time. Entries
+	// changed in other shards meanwhile may or may not be seen.
+	template<typename F>
+	void for_each(F&& func) const {
+		for(std::size_t idx = 0; idx < shard_count_; ++idx) {
+			const Shard& shard = shards_[idx];
+			std::shared_lock lock(shard.mutex_);
+			shard.forEachNode([&func](const Node* node) { std::invoke(func, std::as_const(node->value_)); });
+		}
+	}
+
+	// ============= Capacity ============= //
+
+	// Sum of the shard sizes, each read under its own lock, so not a snapshot
+	// while writers are running.
+	std::size_t size() const {
+		std::size_t ret = 0;
+		for(std::size_t idx = 0; idx < shard_count_; ++idx) {
+			std::shared_lock lock(shards_[idx].mutex_);
+			ret += shards_[idx].size_;
+		}
+		return ret;
+	}
+
+	bool empty() const { return size() == 0; }
+
+	std::size_t shard_count() const noexcept { return shard_count_; }
+
+	// Buckets of the current tables, old tables still being drained excluded.
+	std::size_t bucket_count() const {
+		std::size_t ret = 0;
+		for(std::size_t idx = 0; idx < shard_count_; ++idx) {
+			std::shared_lock lock(shards_[idx].mutex_);
+			ret += shards_[idx].mask_ + 1;
+		}
+		return ret;
+	}
+
+	// True while some shard still holds entries in an old table.
+	bool rehashing() const {
+		for(std::size_t idx = 0; idx < shard_count_; ++idx) {
+			std::shared_lock lock(shards_[idx].mutex_);
+			if(shards_[idx].old_buckets_) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	// A table twice the size of the old one is drained after old_size / migrate_step
+	// writes, well before the shard fills it and has to grow again.
+	static constexpr std::size_t migrate_step = 2;
+	static constexpr std::size_t initial_buckets = 8;
+
+	class Node: public list_hook {
+	public:
+		template<typename... Args>
+		Node(Args&&... args): value_(std::forward<Args>(args)...) {}
+
+		std::size_t hash_{};
+		value_type value_;
+	};
+
+	static std::unique_ptr<list_hook[]> makeBuckets(std::size_t count) {
+		auto buckets = std::make_unique<list_hook[]>(count);
+		for(std::size_t idx = 0; idx < count; ++idx) {
+			buckets[idx].next_ = buckets[idx].prev_ = &buckets[idx];
+		}
+		return buckets;
+	}
+
+	static void linkBack(list_hook& bucket, list_hook* node) noexcept {
+		node->prev_ = bucket.prev_;
+		node->next_ = &bucket;
+		bucket.prev_->next_ = node;
+		bucket.prev_ = node;
+	}
+
+	static void unlinkHook(list_hook* node) noexcept {
+		node->prev_->next_ = node->next_;
+		node->next_->prev_ = node->prev_;
+	}
+
+	struct alignas(64) Shard {
+		Shard(): buckets_(makeBuckets(initial_buckets)), mask_(initial_buckets - 1) {}
+
+		// Moves the entries of up to steps old buckets into the current table.
+		void migrate(std::size_t steps) noexcept {
+			while(old_buckets_ && steps-- > 0) {
+				list_hook& bucket = old_buckets_[migrated_];
+				while(bucket.next_ != &bucket) {
+					list_hook* hook = bucket.next_;
+					unlinkHook(hook);
+					linkBack(buckets_[static_cast<Node*>(hook)->hash_ & mask_], hook);
+				}
+				if(++migrated_ > old_mask_) {
+					old_buckets_.reset();
+				}
+			}
+		}
+
+		void link(Node* node) {
+			if(size_ > mask_) {
+				grow();
+			}
+			linkBack(buckets_[node->hash_ & mask_], node);
+			++size_;
+		}
+
+		void unlink(Node* node) noexcept {
+			unlinkHook(node);
+			--size_;
+		}
+
+		// Only allocates and links the new table; migrate() moves the entries later.
+		// A leftover old table is drained first, which migrate_step makes rare.
+		void grow() {
+			auto buckets = makeBuckets((mask_ + 1) * 2);
+			migrate(static_cast<std::size_t>(-1));
+			old_buckets_ = std::exchange(buckets_, std::move(buckets));
+			old_mask_ = std::exchange(mask_, mask_ * 2 + 1);
+			migrated_ = 0;
+		}
+
+		template<typename F>
+		void forEachNode(F&& func) const {
+			auto walk = [&func](const list_hook* buckets, std::size_t first, std::size_t last) {
+				for(std::size_t idx = first; idx <= last; ++idx) {
+					for(const list_hook* hook = buckets[idx].next_; hook != &buckets[idx]; hook = hook->next_) {
+						func(static_cast<const Node*>(hook));
+					}
+				}
+			};
+			walk(buckets_.get(), 0, mask_);
+			if(old_buckets_) {
+				walk(old_buckets_.get(), migrated_, old_mask_);
+			}
+		}
+
+		void destroyNodes() noexcept {
+			auto destroy = [](list_hook* buckets, std::size_t first, std::size_t last) {
+				for(std::size_t idx = first; idx <= last; ++idx) {
+					list_hook* hook = buckets[idx].next_;
+					while(hook != &buckets[idx]) {
+						list_hook* next = hook->next_;
+						delete static_cast<Node*>(hook);
+						hook = next;
+					}
+					buckets[idx].next_ = buckets[idx].prev_ = &buckets[idx];
+				}
+			};
+			destroy(buckets_.get(), 0, mask_);
+			if(old_buckets_) {
+				destroy(old_buckets_.get(), migrated_, old_mask_);
+				old_buckets_.reset();
+			}
+			size_ = 0;
+		}
+
+		mutable std::shared_mutex mutex_;
+		std::unique_ptr<list_hook[]> buckets_;
+		std::size_t mask_;
+		std::unique_ptr<list_hook[]> old_buckets_;
+		std::size_t old_mask_ = 0;
+		// Old buckets below this index are already empty.
+		std::size_t migrated_ = 0;
+		std::size_t size_ = 0;
+	};
+
+	Node* findInBucket(const list_hook& bucket, std::size_t hash, const Key& key) const {
+		for(list_hook* hook = bucket.next_; hook != &bucket; hook = hook->next_) {
+			auto* node = static_cast<Node*>(hook);
+			if(node->hash_ == hash && equal_(node->value_.first, key)) {
+				return node;
+			}
+		}
+		return nullptr;
+	}
+
+	Node* findNode(const Shard& shard, std::size_t hash, const Key& key) const {
+		if(Node* found = findInBucket(shard.buckets_[hash & shard.mask_], hash, key)) {
+			return found;
+		}
+		if(shard.old_buckets_) {
+			const std::size_t old_idx = hash & shard.old_mask_;
+			if(old_idx >= shard.migrated_) {
+				return findInBucket(shard.old_buckets_[old_idx], hash, key);
+			}
+		}
+		return nullptr;
+	}
+
+	// std::hash is the identity for integers; mixing spreads both the high bits
+	// that pick a shard and the low bits that pick a bucket.
+	std::size_t hashOf(const Key& key) const {
+		return static_cast<std::size_t>(mix64(static_cast<std::uint64_t>(hash_(key))));
+	}
+
+	Shard& shardOf(std::size_t hash) noexcept { return shards_[shardIndex(hash)]; }
+	const Shard& shardOf(std::size_t hash) const noexcept { return shards_[shardIndex(hash)]; }
+	std::size_t shardIndex(std::size_t hash) const noexcept {
+		return shard_count_ == 1 ? 0 : static_cast<std::size_t>(static_cast<std::uint64_t>(hash) >> shard_shift_);
+	}
+
+	std::size_t shard_count_;
+	unsigned shard_shift_;
+	std::unique_ptr<Shard[]> shards_;
+	[[no_unique_address]] Hash hash_;
+	[[no_unique_address]] KeyEqual equal_;
+};
+
+} // namespace exp
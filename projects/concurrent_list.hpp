@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <atomic>
+#include <optional>
+#include <utility>
+#include "hazard_pointers.hpp"
+
+namespace exp {
+
+// Michael-Scott multi-producer multi-consumer queue. head_ always points to a
+// dummy node; popping moves the value out of the node after it and makes that
+// node the new dummy. Nodes are reclaimed through hazard pointers.
+template<typename T>
+class concurrent_queue {
+public:
+	struct BaseNode {
+		std::atomic<BaseNode*> next_{nullptr};
+	};
+
+	class Node: public BaseNode {
+		friend concurrent_queue;
+	public:
+		template<typename... Args>
+		Node(Args&&... args): value_(std::forward<Args>(args)...) {}
+	private:
+		T value_;
+	};
+
+	concurrent_queue() noexcept: head_(&stub_), tail_(&stub_) {}
+	concurrent_queue(const concurrent_queue&) = delete;
+	concurrent_queue& operator=(const concurrent_queue&) = delete;
+
+	// Must not race with other operations.
+	~concurrent_queue() {
+		BaseNode* curr = head_.load(std::memory_order_relaxed);
+		while(curr) {
+			BaseNode* next = curr->next_.load(std::memory_order_relaxed);
+			if(curr != &stub_) {
+				delete static_cast<Node*>(curr);
+			}
+			curr = next;
+		}
+	}
+
+	void push(const T& val) { emplace(val); }
+	void push(T&& val) { emplace(std::move(val)); }
+
+	template<typename... Args>
+	void emplace(Args&&... args) {
+		BaseNode* node = new Node(std::forward<Args>(args)...);
+
+		hazard_guard tail_guard(0);
+		for(;;) {
+			BaseNode* tail = tail_guard.protect(tail_);
+			BaseNode* next = tail->next_.load(std::memory_order_acquire);
+			if(tail != tail_.load(std::memory_order_acquire)) {
+				continue;
+			}
+			if(next) {
+				tail_.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+				continue;
+			}
+			if(tail->next_.compare_exchange_weak(next, node, std::memory_order_release, std::memory_order_relaxed)) {
+				tail_.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+				return;
+			}
+		}
+	}
+
+	std::optional<T> try_pop() {
+		hazard_guard head_guard(0);
+		hazard_guard next_guard(1);
+		for(;;) {
+			BaseNode* head = head_guard.protect(head_);
+			BaseNode* tail = tail_.load(std::memory_order_acquire);
+			BaseNode* next = next_guard.protect(head->next_);
+			if(head != head_.load(std::memory_order_acquire)) {
+				continue;
+			}
+			if(!next) {
+				return std::nullopt;
+			}
+			if(head == tail) {
+				tail_.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+				continue;
+			}
+			if(head_.compare_exchange_strong(head, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+				std::optional<T> value(std::move(static_cast<Node*>(next)->value_));
+				head_guard.reset();
+				if(head != &stub_) {
+					retire(static_cast<Node*>(head));
+				}
+				return value;
+			}
+		}
+	}
+
+	// The head is protected like in try_pop(): a concurrent pop may retire it.
+	bool empty() const {
+		hazard_guard head_guard(0);
+		BaseNode* head = head_guard.protect(head_);
+		return head->next_.load(std::memory_order_acquire) == nullptr;
+	}
+
+private:
+	BaseNode stub_;
+	alignas(64) std::atomic<BaseNode*> head_;
+	alignas(64) std::atomic<BaseNode*> tail_;
+};
+
+// Lock-free singly linked list supporting push_front/pop_front (Treiber stack).
+// Hazard pointers protect the head against reuse, which also rules out ABA.
+template<typename T>
+class lock_free_list {
+public:
+	struct BaseNode {
+		std::atomic<BaseNode*> next_{nullptr};
+	};
+
+	class Node: public BaseNode {
+		friend lock_free_list;
+	public:
+		template<typename... Args>
+		Node(Args&&... args): value_(std::forward<Args>(args)...) {}
+	private:
+		T value_;
+	};
+
+	lock_free_list() noexcept = default;
+	lock_free_list(const lock_free_list&) = delete;
+	lock_free_list& operator=(const lock_free_list&) = delete;
+
+	// Must not race with other operations.
+	~lock_free_list() {
+		BaseNode* curr = head_.load(std::memory_order_relaxed);
+		while(curr) {
+			BaseNode* next = curr->next_.load(std::memory_order_relaxed);
+			delete static_cast<Node*>(curr);
+			curr = next;
+		}
+	}
+
+	void push_front(const T& val) { emplace_front(val); }
+	void push_front(T&& val) { emplace_front(std::move(val)); }
+
+	template<typename... Args>
+	void emplace_front(Args&&... args) {
+		BaseNode* node = new Node(std::forward<Args>(args)...);
+		BaseNode* head = head_.load(std::memory_order_relaxed);
+		do {
+			node->next_.store(head, std::memory_order_relaxed);
+		} while(!head_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	std::optional<T> try_pop_front() {
+		hazard_guard head_guard(0);
+		for(;;) {
+			BaseNode* head = head_guard.protect(head_);
+			if(!head) {
+				return std::nullopt;
+			}
+			BaseNode* next = head->next_.load(std::memory_order_acquire);
+			if(head_.compare_exchange_strong(head, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+				auto* node = static_cast<Node*>(head);
+				std::optional<T> value(std::move(node->value_));
+				head_guard.reset();
+				retire(node);
+				return value;
+			}
+		}
+	}
+
+	bool empty() const noexcept { return head_.load(std::memory_order_acquire) == nullptr; }
+
+private:
+	alignas(64) std::atomic<BaseNode*> head_{nullptr};
+};
+
+} // namespace exp
@@ -25,19 +25,6 @@ concept IsPrintable = requires(T val, std::ostream& os) {
     { os << val } -> std::convertible_to<std::ostream&>;
 };
 
-template<typename... Args, std::invocable<Args...> Callable>
-decltype(auto) time_execution(Callable&& function, Args&&... args) noexcept(std::is_nothrow_invocable_v<Callable, Args...>) {
-    using clock = std::chrono::high_resolution_clock;
-    Defer timeit([start = clock::now()](){
-        try {
-            std::cout << "Execution time is " <<  std::chrono::duration<double>(clock::now() - start).count() << " seconds" << std::endl;
-        } catch(const std::exception& e) {
-            std::cout << e.what() << std::endl;
-        }
-    });
-    return std::invoke(std::forward<Callable>(function), std::forward<Args>(args)...);;
-}
-
 template<typename Cont>
 requires std::forward_iterator<typename Cont::const_iterator>
 void print(const Cont& container) {
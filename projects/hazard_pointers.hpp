@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace exp {
+
+// Hazard pointer based reclamation for the lock-free containers. Every thread
+// owns one record with slots_per_record published pointers; retired objects are
+// freed by the retiring thread once no record publishes them anymore.
+class hazard_pointer_domain {
+public:
+	static constexpr std::size_t max_records = 128;
+	static constexpr std::size_t slots_per_record = 2;
+	static constexpr std::size_t scan_threshold = 2 * max_records * slots_per_record;
+
+	struct Retired {
+		void* ptr_;
+		void (*deleter_)(void*);
+	};
+
+	struct alignas(64) Record {
+		std::atomic<bool> active_{false};
+		std::atomic<void*> slots_[slots_per_record]{};
+	};
+
+	static hazard_pointer_domain& global() {
+		static hazard_pointer_domain domain;
+		return domain;
+	}
+
+	hazard_pointer_domain() = default;
+	hazard_pointer_domain(const hazard_pointer_domain&) = delete;
+	hazard_pointer_domain& operator=(const hazard_pointer_domain&) = delete;
+
+	~hazard_pointer_domain() {
+		for(auto& retired : orphans_) {
+			retired.deleter_(retired.ptr_);
+		}
+	}
+
+	Record* acquireRecord() {
+		for(auto& record : records_) {
+			bool expected = false;
+			if(!record.active_.load(std::memory_order_relaxed) && record.active_.compare_exchange_strong(expected, true)) {
+				return &record;
+			}
+		}
+		throw std::runtime_error("hazard_pointer_domain: too many threads");
+	}
+
+	void releaseRecord(Record* record) noexcept {
+		for(auto& slot : record->slots_) {
+			slot.store(nullptr, std::memory_order_release);
+		}
+		record->active_.store(false, std::memory_order_release);
+	}
+
+	// Frees every retired object that is not published in any record and
+	// leaves the rest in retired.
+	void scan(std::vector<Retired>& retired) {
+		{
+			std::lock_guard lock(orphans_mutex_);
+			retired.insert(retired.end(), orphans_.begin(), orphans_.end());
+			orphans_.clear();
+		}
+
+		std::vector<void*> hazards;
+		hazards.reserve(max_records * slots_per_record);
+		for(auto& record : records_) {
+			if(!record.active_.load(std::memory_order_acquire)) {
+				continue;
+			}
+			for(auto& slot : record.slots_) {
+				if(void* ptr = slot.load(std::memory_order_seq_cst)) {
+					hazards.push_back(ptr);
+				}
+			}
+		}
+		std::sort(hazards.begin(), hazards.end());
+
+		auto still_hazardous = std::partition(retired.begin(), retired.end(), [&hazards](const Retired& r) {
+			return std::binary_search(hazards.begin(), hazards.end(), r.ptr_);
+		});
+		for(auto it = still_hazardous; it != retired.end(); ++it) {
+			it->deleter_(it->ptr_);
+		}
+		retired.erase(still_hazardous, retired.end());
+	}
+
+	void adoptOrphans(std::vector<Retired>& retired) {
+		std::lock_guard lock(orphans_mutex_);
+		orphans_.insert(orphans_.end(), retired.begin(), retired.end());
+		retired.clear();
+	}
+
+private:
+	Record records_[max_records];
+	std::mutex orphans_mutex_;
+	std::vector<Retired> orphans_;
+};
+
+namespace details {
+
+class hazard_thread_state {
+public:
+	hazard_thread_state(): domain_(hazard_pointer_domain::global()), record_(domain_.acquireRecord()) {}
+
+	~hazard_thread_state() {
+		domain_.releaseRecord(record_);
+		domain_.scan(retired_);
+		if(!retired_.empty()) {
+			domain_.adoptOrphans(retired_);
+		}
+	}
+
+	std::atomic<void*>& slot(std::size_t idx) noexcept { return record_->slots_[idx]; }
+
+	void retire(void* ptr, void (*deleter)(void*)) {
+		retired_.push_back({ptr, deleter});
+		if(retired_.size() >= hazard_pointer_domain::scan_threshold) {
+			domain_.scan(retired_);
+		}
+	}
+
+	static hazard_thread_state& local() {
+		static thread_local hazard_thread_state state;
+		return state;
+	}
+private:
+	hazard_pointer_domain& domain_;
+	hazard_pointer_domain::Record* record_;
+	std::vector<hazard_pointer_domain::Retired> retired_;
+};
+
+} // namespace details
+
+// Publishes one pointer in the calling thread's hazard slot for its lifetime.
+class hazard_guard {
+public:
+	explicit hazard_guard(std::size_t slot = 0): slot_(details::hazard_thread_state::local().slot(slot)) {}
+	hazard_guard(const hazard_guard&) = delete;
+	hazard_guard& operator=(const hazard_guard&) = delete;
+	~hazard_guard() { reset(); }
+
+	template<typename T>
+	T* protect(const std::atomic<T*>& src) noexcept {
+		T* ptr = src.load(std::memory_order_relaxed);
+		for(;;) {
+			slot_.store(ptr, std::memory_order_seq_cst);
+			T* reloaded = src.load(std::memory_order_seq_cst);
+			if(reloaded == ptr) {
+				return ptr;
+			}
+			ptr = reloaded;
+		}
+	}
+
+	void reset() noexcept { slot_.store(nullptr, std::memory_order_release); }
+private:
+	std::atomic<void*>& slot_;
+};
+
+template<typename T>
+void retire(T* ptr) {
+	details::hazard_thread_state::local().retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+}
+
+} // namespace exp
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Low overhead measurement: scoped timers push (name, start, duration) events
+// into a per-thread SPSC ring, a collector drains all rings into a Chrome trace
+// (chrome://tracing, Perfetto) and latency_histogram keeps p50/p99/p999.
+//
+// The EXP_TRACE_SCOPE macros expand to nothing unless EXP_INSTRUMENTATION is
+// defined, the classes themselves are always available.
+
+#if defined(EXP_INSTRUMENTATION)
+#define EXP_INSTR_CONCAT_IMPL(a, b) a##b
+#define EXP_INSTR_CONCAT(a, b) EXP_INSTR_CONCAT_IMPL(a, b)
+#define EXP_TRACE_SCOPE(name) \
+    ::exp::instrumentation::scoped_timer EXP_INSTR_CONCAT(exp_trace_scope_, __LINE__)(name)
+#define EXP_TRACE_SCOPE_HIST(name, histogram) \
+    ::exp::instrumentation::scoped_timer EXP_INSTR_CONCAT(exp_trace_scope_, __LINE__)(name, &(histogram))
+#else
+#define EXP_TRACE_SCOPE(name) static_cast<void>(0)
+#define EXP_TRACE_SCOPE_HIST(name, histogram) static_cast<void>(0)
+#endif
+
+namespace exp::instrumentation {
+
+// ============= Clock ============= //
+
+// Raw cycle counter (rdtsc on x86, cntvct_el0 on arm64, steady_clock ns elsewhere),
+// converted to nanoseconds with a ratio measured once against steady_clock.
+class tsc_clock {
+public:
+    static std::uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+        std::uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    static double ticks_per_ns() noexcept { return calibration().ticks_per_ns_; }
+
+    // Tick count taken during calibration, trace timestamps are relative to it.
+    static std::uint64_t origin() noexcept { return calibration().origin_; }
+
+    static std::uint64_t to_ns(std::uint64_t ticks) noexcept {
+        return static_cast<std::uint64_t>(static_cast<double>(ticks) / ticks_per_ns());
+    }
+
+    // Forces calibration (about 10 ms of spinning). Registering a thread's event
+    // ring does it, so no timed scope pays for it and trace timestamps never
+    // precede the origin.
+    static void calibrate() noexcept { calibration(); }
+
+private:
+    struct Calibration {
+        double ticks_per_ns_;
+        std::uint64_t origin_;
+    };
+
+    static const Calibration& calibration() noexcept {
+        static const Calibration result = [] {
+            using clock = std::chrono::steady_clock;
+            const auto wall_begin = clock::now();
+            const std::uint64_t ticks_begin = now();
+            while(clock::now() - wall_begin < std::chrono::milliseconds(10)) {}
+            const std::uint64_t ticks_end = now();
+            const auto wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - wall_begin).count();
+            const double ratio = static_cast<double>(ticks_end - ticks_begin) / static_cast<double>(wall_ns);
+            return Calibration{ratio > 0 ? ratio : 1.0, ticks_begin};
+        }();
+        return result;
+    }
+};
+
+// ============= Histogram ============= //
+
+// Log-linear (HDR style) histogram of nanosecond values. Values below 2^sub_bucket_bits
+// are exact, above that every power of two is split into 2^(sub_bucket_bits - 1)
+// linear buckets, so the relative error stays under 1/64. Recording is a relaxed
+// atomic increment and may happen from any thread.
+class latency_histogram {
+public:
+    static constexpr unsigned sub_bucket_bits = 7;
+    static constexpr std::size_t sub_bucket_count = std::size_t{1} << sub_bucket_bits;
+    static constexpr std::size_t half_count = sub_bucket_count / 2;
+    static constexpr std::size_t bucket_count = sub_bucket_count + (64 - sub_bucket_bits) * half_count;
+
+    void record(std::uint64_t value) noexcept {
+        counts_[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t max = max_.load(std::memory_order_relaxed);
+        while(value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+    }
+
+    std::uint64_t count() const noexcept { return total_.load(std::memory_order_relaxed); }
+    std::uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding the q-th quantile, q in [0, 1].
+    std::uint64_t quantile(double q) const noexcept {
+        const std::uint64_t total = count();
+        if(total == 0) {
+            return 0;
+        }
+        auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total));
+        rank = std::clamp<std::uint64_t>(rank, 1, total);
+        std::uint64_t seen = 0;
+        for(std::size_t idx = 0; idx < bucket_count; ++idx) {
+            seen += counts_[idx].load(std::memory_order_relaxed);
+            if(seen >= rank) {
+                return std::min(bucketUpperBound(idx), max());
+            }
+        }
+        return max();
+    }
+
+    void merge(const latency_histogram& other) noexcept {
+        for(std::size_t idx = 0; idx < bucket_count; ++idx) {
+            counts_[idx].fetch_add(other.counts_[idx].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        total_.fetch_add(other.count(), std::memory_order_relaxed);
+        std::uint64_t max = max_.load(std::memory_order_relaxed);
+        const std::uint64_t other_max = other.max();
+        while(other_max > max && !max_.compare_exchange_weak(max, other_max, std::memory_order_relaxed)) {}
+    }
+
+    void reset() noexcept {
+        for(auto& counter : counts_) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        total_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    // "name: n=... p50=...ns p99=...ns p999=...ns max=...ns"
+    void write_summary(std::ostream& os, std::string_view name) const {
+        os << name << ": n=" << count() << " p50=" << quantile(0.5) << "ns p99=" << quantile(0.99)
+           << "ns p999=" << quantile(0.999) << "ns max=" << max() << "ns\n";
+    }
+
+    static constexpr std::size_t bucketOf(std::uint64_t value) noexcept {
+        if(value < sub_bucket_count) {
+            return static_cast<std::size_t>(value);
+        }
+        const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - sub_bucket_bits;
+        const auto mantissa = static_cast<std::size_t>(value >> shift);
+        return sub_bucket_count + (shift - 1) * half_count + (mantissa - half_count);
+    }
+
+    static constexpr std::uint64_t bucketUpperBound(std::size_t idx) noexcept {
+        if(idx < sub_bucket_count) {
+            return idx;
+        }
+        const std::size_t shift = (idx - sub_bucket_count) / half_count + 1;
+        const std::uint64_t mantissa = (idx - sub_bucket_count) % half_count + half_count;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, bucket_count> counts_{};
+    std::atomic<std::uint64_t> total_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+// ============= Event rings ============= //
+
+// name must have static storage duration, only the pointer is kept.
+struct trace_event {
+    const char* name_;
+    std::uint64_t start_;
+    std::uint64_t duration_;
+};
+
+// Single producer (the owning thread), single consumer (the collector) ring.
+// A full ring drops new events and counts them instead of blocking the producer.
+class event_ring {
+public:
+    static constexpr std::size_t default_capacity = 1 << 14;
+
+    explicit event_ring(std::size_t capacity = default_capacity, std::uint32_t thread_id = 0):
+        events_(std::make_unique<trace_event[]>(std::bit_ceil(capacity))),
+        mask_(std::bit_ceil(capacity) - 1),
+        thread_id_(thread_id) {}
+
+    bool try_push(const trace_event& event) noexcept {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if(head - tail_.load(std::memory_order_acquire) > mask_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        events_[head & mask_] = event;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Hands every pending event to sink, returns how many there were.
+    template<typename Sink>
+    std::size_t drain(Sink&& sink) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        const std::size_t count = head - tail;
+        for(; tail != head; ++tail) {
+            sink(events_[tail & mask_]);
+        }
+        tail_.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    std::uint32_t thread_id() const noexcept { return thread_id_; }
+    bool empty() const noexcept { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+    // Hands a drained ring to another thread. Nothing may push to it meanwhile.
+    void reassign(std::uint32_t thread_id) noexcept { thread_id_ = thread_id; }
+
+private:
+    std::unique_ptr<trace_event[]> events_;
+    std::size_t mask_;
+    std::uint32_t thread_id_;
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+struct collected_event {
+    trace_event event_;
+    std::uint32_t thread_id_;
+};
+
+// Owns the ring of every thread that recorded an event. A ring outlives its
+// thread until its events are drained, then the next new thread reuses it, so
+// thread churn doesn't grow the registry past the peak number of threads.
+class trace_registry {
+public:
+    static trace_registry& global() {
+        static trace_registry registry;
+        return registry;
+    }
+
+    event_ring& thread_ring() {
+        thread_local RingOwner owner(*this);
+        return *owner.ring_;
+    }
+
+    // Moves the pending events of all threads into out.
+    void drain(std::vector<collected_event>& out) {
+        std::lock_guard lock(mutex_);
+        for(auto& ring : rings_) {
+            ring->drain([&out, &ring](const trace_event& event) { out.push_back({event, ring->thread_id()}); });
+        }
+        free_.insert(free_.end(), retired_.begin(), retired_.end());
+        retired_.clear();
+    }
+
+    // Rings allocated so far, in use or waiting for reuse.
+    std::size_t ring_count() {
+        std::lock_guard lock(mutex_);
+        return rings_.size();
+    }
+
+    std::uint64_t dropped() {
+        std::lock_guard lock(mutex_);
+        std::uint64_t dropped = 0;
+        for(const auto& ring : rings_) {
+            dropped += ring->dropped();
+        }
+        return dropped;
+    }
+
+private:
+    // Returns the ring of a thread to the registry when the thread exits.
+    struct RingOwner {
+        explicit RingOwner(trace_registry& registry): registry_(registry), ring_(registry.registerThread()) {}
+        RingOwner(const RingOwner&) = delete;
+        RingOwner& operator=(const RingOwner&) = delete;
+        ~RingOwner() { registry_.releaseThread(ring_); }
+
+        trace_registry& registry_;
+        event_ring* ring_;
+    };
+
+    trace_registry() = default;
+
+    event_ring* registerThread() {
+        tsc_clock::calibrate();
+        std::lock_guard lock(mutex_);
+        const std::uint32_t thread_id = ++last_thread_id_;
+        if(!free_.empty()) {
+            event_ring* ring = free_.back();
+            free_.pop_back();
+            ring->reassign(thread_id);
+            return ring;
+        }
+        // Reserved up front so a thread exit never allocates.
+        retired_.reserve(rings_.size() + 1);
+        free_.reserve(rings_.size() + 1);
+        return rings_.emplace_back(std::make_unique<event_ring>(event_ring::default_capacity, thread_id)).get();
+    }
+
+    void releaseThread(event_ring* ring) noexcept {
+        std::lock_guard lock(mutex_);
+        (ring->empty() ? free_ : retired_).push_back(ring);
+    }
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<event_ring>> rings_;
+    // Rings of exited threads, with events still pending and drained ones.
+    std::vector<event_ring*> retired_;
+    std::vector<event_ring*> free_;
+    std::uint32_t last_thread_id_ = 0;
+};
+
+// ============= Scoped timer ============= //
+
+// The thread's ring is looked up before the start tick is read, so the first
+// scope of a thread does not time the ring's registration and calibration.
+class scoped_timer {
+public:
+    explicit scoped_timer(const char* name, latency_histogram* histogram = nullptr):
+        ring_(trace_registry::global().thread_ring()), name_(name), histogram_(histogram), start_(tsc_clock::now()) {}
+
+    scoped_timer(const scoped_timer&) = delete;
+    scoped_timer& operator=(const scoped_timer&) = delete;
+
+    ~scoped_timer() {
+        const std::uint64_t duration = tsc_clock::now() - start_;
+        ring_.try_push({name_, start_, duration});
+        if(histogram_) {
+            histogram_->record(tsc_clock::to_ns(duration));
+        }
+    }
+
+private:
+    event_ring& ring_;
+    const char* name_;
+    latency_histogram* histogram_;
+    std::uint64_t start_;
+};
+
+// ============= Chrome trace export ============= //
+
+namespace details {
+
+inline void write_json_string(std::ostream& os, std::string_view str) {
+    os << '"';
+    for(char ch : str) {
+        if(ch == '"' || ch == '\\') {
+            os << '\\' << ch;
+        } else if(static_cast<unsigned char>(ch) < 0x20) {
+            os << ' ';
+        } else {
+            os << ch;
+        }
+    }
+    os << '"';
+}
+
+// Chrome trace timestamps are microseconds, printed with nanosecond digits.
+inline void write_micros(std::ostream& os, std::uint64_t ns) {
+    const std::uint64_t frac = ns % 1000;
+    os << ns / 1000 << '.' << static_cast<char>('0' + frac / 100) << static_cast<char>('0' + frac / 10 % 10)
+       << static_cast<char>('0' + frac % 10);
+}
+
+} // namespace details
+
+// Complete ("X") events in the Trace Event Format read by chrome://tracing and Perfetto.
+inline void write_chrome_trace(std::ostream& os, const std::vector<collected_event>& events) {
+    const std::uint64_t origin = tsc_clock::origin();
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for(const auto& [event, thread_id] : events) {
+        os << (first ? "\n" : ",\n") << "{\"name\":";
+        details::write_json_string(os, event.name_);
+        os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread_id << ",\"ts\":";
+        details::write_micros(os, tsc_clock::to_ns(event.start_ > origin ? event.start_ - origin : 0));
+        os << ",\"dur\":";
+        details::write_micros(os, tsc_clock::to_ns(event.duration_));
+        os << '}';
+        first = false;
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+// Drains every thread's ring into a trace file, returns the number of events written.
+inline std::size_t write_chrome_trace(const std::string& path) {
+    std::vector<collected_event> events;
+    trace_registry::global().drain(events);
+    std::ofstream file(path);
+    if(!file) {
+        throw std::runtime_error("Can't open trace file " + path);
+    }
+    write_chrome_trace(file, events);
+    return events.size();
+}
+
+} // namespace exp::instrumentation
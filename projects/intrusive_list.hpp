@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "iterator.hpp"
+#include "list_hook.hpp"
+
+namespace exp {
+
+// Doubly linked list over objects that embed a list_hook member, named by Hook.
+// The list never allocates and never owns its elements: linking and unlinking
+// only rewrite the hook pointers, and an object can be unlinked in O(1) from a
+// reference alone. Objects must outlive their membership, the destructor unlinks
+// whatever is still in the list. An object is in at most one list per hook.
+template<typename T, list_hook T::* Hook>
+class intrusive_list {
+public:
+	using value_type = T;
+	using reference = T&;
+	using const_reference = const T&;
+	using size_type = std::size_t;
+
+	// ============= Iterator ============= //
+
+	template<bool isConst>
+	class intrusive_iterator: public iterator_facade<intrusive_iterator<isConst>, std::conditional_t<isConst, const T, T>, std::bidirectional_iterator_tag> {
+		friend intrusive_list;
+	public:
+		using hook_pointer = std::conditional_t<isConst, const list_hook*, list_hook*>;
+		using reference = std::conditional_t<isConst, const T&, T&>;
+
+		intrusive_iterator() noexcept = default;
+		explicit intrusive_iterator(hook_pointer hook) noexcept: hook_(hook) {}
+
+		template<bool wasConst>
+		requires (isConst && !wasConst)
+		intrusive_iterator(const intrusive_iterator<wasConst>& other) noexcept: hook_(other.hook_) {}
+
+		reference dereference() const noexcept { return *fromHook(hook_); }
+		void increment() noexcept { hook_ = hook_->next_; }
+		void decrement() noexcept { hook_ = hook_->prev_; }
+
+		bool equal(const intrusive_iterator& rhs) const noexcept { return hook_ == rhs.hook_; }
+	private:
+		hook_pointer hook_ = nullptr;
+	};
+
+	using iterator = intrusive_iterator<false>;
+	using const_iterator = intrusive_iterator<true>;
+
+	// ==================================== //
+
+	intrusive_list() noexcept {
+		head_.next_ = &head_;
+		head_.prev_ = &head_;
+	}
+
+	intrusive_list(const intrusive_list&) = delete;
+	intrusive_list& operator=(const intrusive_list&) = delete;
+
+	intrusive_list(intrusive_list&& other) noexcept: intrusive_list() {
+		splice(end(), other);
+	}
+
+	intrusive_list& operator=(intrusive_list&& other) noexcept {
+		if(this != &other) {
+			clear();
+			splice(end(), other);
+		}
+		return *this;
+	}
+
+	~intrusive_list() { clear(); }
+
+	iterator begin() noexcept { return iterator(head_.next_); }
+	const_iterator begin() const noexcept { return cbegin(); }
+	const_iterator cbegin() const noexcept { return const_iterator(head_.next_); }
+
+	iterator end() noexcept { return iterator(&head_); }
+	const_iterator end() const noexcept { return cend(); }
+	const_iterator cend() const noexcept { return const_iterator(&head_); }
+
+	size_type size() const noexcept { return size_; }
+	bool empty() const noexcept { return size_ == 0; }
+
+	T& front() noexcept { return *fromHook(head_.next_); }
+	T& back() noexcept { return *fromHook(head_.prev_); }
+
+	// Iterator to an object known to be in this list.
+	iterator iterator_to(T& value) noexcept { return iterator(&(value.*Hook)); }
+	const_iterator iterator_to(const T& value) const noexcept { return const_iterator(&(value.*Hook)); }
+
+	iterator insert(iterator pos, T& value) noexcept {
+		list_hook* hook = &(value.*Hook);
+		list_hook* next = pos.hook_;
+		list_hook* prev = next->prev_;
+
+		hook->next_ = next;
+		hook->prev_ = prev;
+		prev->next_ = hook;
+		next->prev_ = hook;
+		++size_;
+
+		return iterator(hook);
+	}
+
+	void push_back(T& value) noexcept { insert(end(), value); }
+	void push_front(T& value) noexcept { insert(begin(), value); }
+
+	iterator erase(iterator pos) noexcept {
+		list_hook* hook = pos.hook_;
+		list_hook* next = hook->next_;
+
+		unlinkHook(hook);
+		--size_;
+
+		return iterator(next);
+	}
+
+	// O(1) removal of an object known to be in this list.
+	void remove(T& value) noexcept { erase(iterator_to(value)); }
+
+	void pop_front() noexcept { erase(begin()); }
+	void pop_back() noexcept { erase(iterator(head_.prev_)); }
+
+	// Unlinks every element, the objects themselves are untouched.
+	void clear() noexcept {
+		list_hook* curr = head_.next_;
+		while(curr != &head_) {
+			list_hook* next = curr->next_;
+			curr->next_ = nullptr;
+			curr->prev_ = nullptr;
+			curr = next;
+		}
+		head_.next_ = &head_;
+		head_.prev_ = &head_;
+		size_ = 0;
+	}
+
+	// Moves one element of other in front of pos, e.g. from an idle list to the
+	// head of an LRU list.
+	void splice(iterator pos, intrusive_list& other, iterator it) noexcept {
+		if(it.hook_ == pos.hook_ || it.hook_->next_ == pos.hook_) {
+			return;
+		}
+		T& value = *it;
+		other.erase(it);
+		insert(pos, value);
+	}
+
+	void splice(iterator pos, intrusive_list& other) noexcept {
+		if(other.empty() || this == &other) {
+			return;
+		}
+		list_hook* first = other.head_.next_;
+		list_hook* last = other.head_.prev_;
+		list_hook* next = pos.hook_;
+		list_hook* prev = next->prev_;
+
+		prev->next_ = first;
+		first->prev_ = prev;
+		last->next_ = next;
+		next->prev_ = last;
+		size_ += std::exchange(other.size_, 0);
+
+		other.head_.next_ = &other.head_;
+		other.head_.prev_ = &other.head_;
+	}
+
+private:
+	// Distance from the start of T to its hook member. The Itanium C++ ABI of GCC
+	// and Clang stores a data member pointer as exactly that offset, so it is
+	// read straight from Hook. Elsewhere it is measured once on a value-initialized
+	// T, so T has to be default constructible there.
+	static std::ptrdiff_t hookOffset() noexcept {
+#if defined(__GNUC__)
+		static_assert(sizeof(Hook) == sizeof(std::ptrdiff_t));
+		return std::bit_cast<std::ptrdiff_t>(Hook);
+#else
+		static_assert(std::is_default_constructible_v<T>, "intrusive_list needs a default constructible T to find its hook");
+		static const std::ptrdiff_t offset = [] {
+			const T object{};
+			return reinterpret_cast<const std::byte*>(std::addressof(object.*Hook)) - reinterpret_cast<const std::byte*>(std::addressof(object));
+		}();
+		return offset;
+#endif
+	}
+
+	static T* fromHook(list_hook* hook) noexcept {
+		return reinterpret_cast<T*>(reinterpret_cast<std::byte*>(hook) - hookOffset());
+	}
+	static const T* fromHook(const list_hook* hook) noexcept {
+		return reinterpret_cast<const T*>(reinterpret_cast<const std::byte*>(hook) - hookOffset());
+	}
+
+	static void unlinkHook(list_hook* hook) noexcept {
+		hook->prev_->next_ = hook->next_;
+		hook->next_->prev_ = hook->prev_;
+		hook->next_ = nullptr;
+		hook->prev_ = nullptr;
+	}
+
+	list_hook head_;
+	size_type size_{};
+};
+
+} // namespace exp
@@ -6,9 +6,13 @@
 
 #pragma once 
 
+#include <compare>
+#include <concepts>
 #include <type_traits>
 #include <iterator>
 #include <iostream>
+#include <tuple>
+#include <utility>
 #include "type_traits.hpp"
 
 template<
@@ -22,12 +26,12 @@ class iterator_facade {
 public:
     using value_type = std::remove_const_t<Value>;
     using reference = Reference;
-    using pointer = value_type*;
+    using pointer = std::conditional_t<std::is_lvalue_reference_v<Reference>, std::add_pointer_t<Reference>, value_type*>;
     using iterator_category = Category;
     using difference_type = DiffT;
 
     reference operator*() const { return asDerived().dereference(); }
-    pointer operator->() { return std::addressof(asDerived().dereference()); }
+    pointer operator->() const requires std::is_lvalue_reference_v<reference> { return std::addressof(asDerived().dereference()); }
 
     Derived& operator++() { asDerived().increment(); return asDerived(); }
 
@@ -45,8 +49,40 @@ public:
         return tmp;
     }
 
-    Derived& operator+=(difference_type n) { std::advance(asDerived(), n); return asDerived(); }
-    Derived& operator-=(difference_type n) { std::advance(asDerived(), -n); return asDerived(); }
+    // Derived may provide advance(n) and distance_to(other) for O(1) jumps, otherwise
+    // += steps one element at a time and the arithmetic operators are not offered.
+    Derived& operator+=(difference_type n) {
+        if constexpr (requires(Derived& it) { it.advance(n); }) {
+            asDerived().advance(n);
+        } else {
+            for(; n > 0; --n) {
+                asDerived().increment();
+            }
+            for(; n < 0; ++n) {
+                asDerived().decrement();
+            }
+        }
+        return asDerived();
+    }
+    Derived& operator-=(difference_type n) { return *this += -n; }
+
+    friend Derived operator+(Derived it, difference_type n) requires requires { it.advance(n); } { return it += n; }
+    friend Derived operator+(difference_type n, Derived it) requires requires { it.advance(n); } { return it += n; }
+    friend Derived operator-(Derived it, difference_type n) requires requires { it.advance(n); } { return it -= n; }
+
+    friend difference_type operator-(const Derived& lhs, const Derived& rhs) requires requires { rhs.distance_to(lhs); } {
+        return rhs.distance_to(lhs);
+    }
+
+    reference operator[](difference_type n) const requires requires(Derived it) { it.advance(n); } {
+        Derived tmp = asDerived();
+        tmp.advance(n);
+        return tmp.dereference();
+    }
+
+    friend std::strong_ordering operator<=>(const Derived& lhs, const Derived& rhs) requires requires { lhs.distance_to(rhs); } {
+        return 0 <=> lhs.distance_to(rhs);
+    }
 
     friend bool operator==(const iterator_facade& lhs, const iterator_facade& rhs) {
         return lhs.asDerived().equal(rhs.asDerived());
@@ -72,26 +108,111 @@ void print_ref_category(T&&) {
     std::cout << std::endl;
 }
 
+// std::tuple with the glue a proxy reference needs: a tuple of references assigns
+// through even when const, swap exchanges the referenced values and it has a
+// common reference with the tuple of values. This is what lets zip_iterator model
+// std::random_access_iterator and be sorted in place.
+template<typename... Ts>
+class zip_tuple: public std::tuple<Ts...> {
+    using BaseType = std::tuple<Ts...>;
+public:
+    using BaseType::BaseType;
+
+    zip_tuple(const BaseType& other): BaseType(other) {}
+    zip_tuple(BaseType&& other): BaseType(std::move(other)) {}
+
+    // References to the elements of a tuple of values.
+    template<typename... Us>
+    requires (sizeof...(Us) == sizeof...(Ts) && !std::is_same_v<zip_tuple<Us...>, zip_tuple> && (std::is_constructible_v<Ts, Us&> && ...))
+    zip_tuple(zip_tuple<Us...>& other):
+        BaseType(std::apply([](auto&... elems) { return BaseType(elems...); }, static_cast<std::tuple<Us...>&>(other))) {}
+
+    template<typename... Us>
+    requires (sizeof...(Us) == sizeof...(Ts) && (std::is_assignable_v<Ts&, const Us&> && ...))
+    zip_tuple& operator=(const std::tuple<Us...>& other) {
+        BaseType::operator=(other);
+        return *this;
+    }
+
+    template<typename... Us>
+    requires (sizeof...(Us) == sizeof...(Ts) && (std::is_assignable_v<Ts&, Us> && ...))
+    zip_tuple& operator=(std::tuple<Us...>&& other) {
+        BaseType::operator=(std::move(other));
+        return *this;
+    }
+
+    template<typename... Us>
+    requires (sizeof...(Us) == sizeof...(Ts) && (std::is_reference_v<Ts> && ...) && (std::is_assignable_v<Ts, const Us&> && ...))
+    const zip_tuple& operator=(const std::tuple<Us...>& other) const {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((std::get<I>(*this) = std::get<I>(other)), ...);
+        }(std::index_sequence_for<Ts...>{});
+        return *this;
+    }
+
+    template<typename... Us>
+    requires (sizeof...(Us) == sizeof...(Ts) && (std::is_reference_v<Ts> && ...) && (std::is_assignable_v<Ts, Us> && ...))
+    const zip_tuple& operator=(std::tuple<Us...>&& other) const {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((std::get<I>(*this) = std::forward<Us>(std::get<I>(other))), ...);
+        }(std::index_sequence_for<Ts...>{});
+        return *this;
+    }
+
+    friend void swap(const zip_tuple& lhs, const zip_tuple& rhs) requires (std::is_reference_v<Ts> && ...) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (std::ranges::swap(std::get<I>(lhs), std::get<I>(rhs)), ...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+};
+
+template<typename... Ts>
+struct std::tuple_size<zip_tuple<Ts...>>: std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template<std::size_t I, typename... Ts>
+struct std::tuple_element<I, zip_tuple<Ts...>>: std::tuple_element<I, std::tuple<Ts...>> {};
+
+template<typename... Ts, typename... Us, template<typename> class TQual, template<typename> class UQual>
+requires (sizeof...(Ts) == sizeof...(Us)) && requires { typename zip_tuple<std::common_reference_t<TQual<Ts>, UQual<Us>>...>; }
+struct std::basic_common_reference<zip_tuple<Ts...>, zip_tuple<Us...>, TQual, UQual> {
+    using type = zip_tuple<std::common_reference_t<TQual<Ts>, UQual<Us>>...>;
+};
+
+template<typename... Ts, typename... Us>
+requires (sizeof...(Ts) == sizeof...(Us)) && requires { typename zip_tuple<std::common_type_t<Ts, Us>...>; }
+struct std::common_type<zip_tuple<Ts...>, zip_tuple<Us...>> {
+    using type = zip_tuple<std::common_type_t<Ts, Us>...>;
+};
+
+// Random access when every iterator is, never contiguous: rows are not objects in memory.
+template<typename... Its>
+using zip_iterator_tag = std::conditional_t<
+    std::is_base_of_v<std::random_access_iterator_tag, common_it_tag<Its...>>,
+    std::random_access_iterator_tag,
+    common_it_tag<Its...>>;
+
 template<typename... Its>
 class zip_iterator: public iterator_facade<
     zip_iterator<Its...>,
-    std::tuple<std::iter_reference_t<Its>...>,
-    common_it_tag<std::remove_cvref_t<Its>...>,
-    std::tuple<std::iter_value_t<Its>...>>
+    zip_tuple<typename std::iterator_traits<std::remove_cvref_t<Its>>::value_type...>,
+    zip_iterator_tag<std::remove_cvref_t<Its>...>,
+    zip_tuple<typename std::iterator_traits<std::remove_cvref_t<Its>>::reference...>>
 {
     using BaseType = iterator_facade<
         zip_iterator<Its...>, 
-        std::tuple<typename std::iterator_traits<std::remove_cvref_t<Its>>::value_type...>, 
-        common_it_tag<std::remove_cvref_t<Its>...>,
-        std::tuple<typename std::iterator_traits<std::remove_cvref_t<Its>>::reference...>
+        zip_tuple<typename std::iterator_traits<std::remove_cvref_t<Its>>::value_type...>, 
+        zip_iterator_tag<std::remove_cvref_t<Its>...>,
+        zip_tuple<typename std::iterator_traits<std::remove_cvref_t<Its>>::reference...>
     >;
 public:
     using value_type = typename BaseType::value_type;
     using reference = typename BaseType::reference;
-    using iterator_category = common_it_tag<std::remove_cvref_t<Its>...>;
+    using iterator_category = typename BaseType::iterator_category;
+    using iterator_concept = iterator_category;
     using difference_type = typename BaseType::difference_type;
     using pointer = void;
 
+    constexpr zip_iterator() = default;
     constexpr zip_iterator(Its... args): iterators_(args...) {}
     
     reference dereference() const noexcept { 
@@ -101,6 +222,14 @@ public:
     void increment() { std::apply([](auto&... its){ (++its, ...); }, iterators_); };
     void decrement() { std::apply([](auto&... its){ (--its, ...); }, iterators_); };
 
+    void advance(difference_type n) requires (std::random_access_iterator<Its> && ...) {
+        std::apply([n](auto&... its){ ((its += n), ...); }, iterators_);
+    }
+
+    difference_type distance_to(const zip_iterator& other) const requires (std::random_access_iterator<Its> && ...) {
+        return std::get<0>(other.iterators_) - std::get<0>(iterators_);
+    }
+
     bool equal(const zip_iterator& other) const noexcept { 
         auto impl = [this, &other]<std::size_t... I>(std::index_sequence<I...>){
             return ((std::get<I>(other.iterators_) == std::get<I>(iterators_)) && ...);
@@ -108,10 +237,28 @@ public:
         return impl(std::index_sequence_for<Its...>{}); 
     };
 
+    friend auto iter_move(const zip_iterator& it) {
+        return std::apply([](const auto&... its) {
+            return zip_tuple<std::iter_rvalue_reference_t<Its>...>(std::ranges::iter_move(its)...);
+        }, it.iterators_);
+    }
+
+    friend void iter_swap(const zip_iterator& lhs, const zip_iterator& rhs) requires (std::indirectly_swappable<Its> && ...) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (std::ranges::iter_swap(std::get<I>(lhs.iterators_), std::get<I>(rhs.iterators_)), ...);
+        }(std::index_sequence_for<Its...>{});
+    }
+
 private:
     std::tuple<Its...> iterators_;
 };
 
+// Tag for building a zip_range whose ranges are known to have equal sizes.
+struct zip_unchecked_t {
+    explicit zip_unchecked_t() = default;
+};
+inline constexpr zip_unchecked_t zip_unchecked{};
+
 template<typename... Ranges>
 class zip_range {
 public:
@@ -121,6 +268,9 @@ public:
     using iterator = zip_iterator<decltype(std::begin(std::declval<Ranges&>()))...>;
     using difference_type = std::ptrdiff_t;
 
+    static constexpr std::size_t columns = sizeof...(Ranges);
+    static constexpr bool is_contiguous = (std::contiguous_iterator<decltype(std::begin(std::declval<Ranges&>()))> && ...);
+
     template<typename... Args>
     zip_range(Args&&... args): ranges_(std::forward<Args>(args)...) {
         if(!is_equal_sizes()) {
@@ -128,8 +278,18 @@ public:
         }
      }
 
+    template<typename... Args>
+    zip_range(zip_unchecked_t, Args&&... args): ranges_(std::forward<Args>(args)...) {}
+
     iterator begin() { return std::apply([](auto&&... ranges){ return iterator(std::begin(ranges)...); }, ranges_); }
     iterator end() { return std::apply([](auto&&... ranges){ return iterator(std::end(ranges)...); }, ranges_); }
+
+    std::size_t size() const { return std::size(std::get<0>(ranges_)); }
+
+    template<std::size_t I>
+    auto& get() noexcept { return std::get<I>(ranges_); }
+    template<std::size_t I>
+    const auto& get() const noexcept { return std::get<I>(ranges_); }
 private:
 
     constexpr bool is_equal_sizes() const {
@@ -5,21 +5,107 @@
  */
 
 #pragma once 
+#include <cassert>
 #include <iterator>
 #include <utility>
 #include <exception>
 #include <list>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <ranges>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
 #include "iterator.hpp"
 #include "concepts.hpp"
+#include "list_hook.hpp"
+#include "allocation_stats.hpp"
+#include "instrumentation.hpp"
 
 namespace exp {
 
-template<typename T>
+namespace details {
+
+// Slots for the first N nodes of a list, kept inside the list object itself.
+// One bit per slot marks it free.
+template<typename Node, std::size_t N>
+class inline_nodes {
+	static_assert(N <= 64, "inline_nodes supports at most 64 slots");
+public:
+	inline_nodes() noexcept = default;
+	inline_nodes(const inline_nodes&) = delete;
+	inline_nodes& operator=(const inline_nodes&) = delete;
+
+	// Raw storage for one node, nullptr when every slot is taken.
+	Node* take() noexcept {
+		if(free_ == 0) {
+			return nullptr;
+		}
+		const int idx = std::countr_zero(free_);
+		free_ &= free_ - 1;
+		return slot(idx);
+	}
+
+	void give(Node* node) noexcept {
+		free_ |= std::uint64_t{1} << ((reinterpret_cast<std::byte*>(node) - bytes_) / sizeof(Node));
+	}
+
+	bool owns(const void* node) const noexcept {
+		const auto* ptr = static_cast<const std::byte*>(node);
+		return !std::less<const std::byte*>{}(ptr, bytes_) && std::less<const std::byte*>{}(ptr, bytes_ + sizeof(bytes_));
+	}
+
+	std::size_t available() const noexcept { return static_cast<std::size_t>(std::popcount(free_)); }
+	std::size_t used() const noexcept { return N - available(); }
+
+	// Calls func(node) for every slot taken when the call starts.
+	template<typename F>
+	void for_each_used(F func) {
+		for(std::uint64_t used = ~free_ & all; used != 0; used &= used - 1) {
+			func(slot(std::countr_zero(used)));
+		}
+	}
+
+private:
+	static constexpr std::uint64_t all = N == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << N) - 1;
+
+	Node* slot(int idx) noexcept { return reinterpret_cast<Node*>(bytes_ + static_cast<std::size_t>(idx) * sizeof(Node)); }
+
+	alignas(Node) std::byte bytes_[N * sizeof(Node)];
+	std::uint64_t free_ = all;
+};
+
+template<typename Node>
+class inline_nodes<Node, 0> {
+public:
+	Node* take() noexcept { return nullptr; }
+	void give(Node*) noexcept {}
+	bool owns(const void*) const noexcept { return false; }
+	std::size_t available() const noexcept { return 0; }
+	std::size_t used() const noexcept { return 0; }
+	template<typename F>
+	void for_each_used(F) noexcept {}
+};
+
+} // namespace details
+
+// With InlineNodes > 0 the first InlineNodes nodes live inside the list object
+// and only longer lists touch the allocator. Nodes stored inline are moved, not
+// relinked, when they change owner (move, swap, splice or merge from another
+// list), so iterators to them do not follow the element to the other list.
+template<typename T, typename Allocator = default_allocator<T>, size_t InlineNodes = 0>
 class list {
+	static_assert(InlineNodes == 0 || std::is_nothrow_move_constructible_v<T>, "inline nodes are moved between lists, T must be nothrow move constructible");
 public:
 
 	class Node;
-	struct BaseNode;
+	using BaseNode = list_hook;
+
+	using value_type = T;
+	using allocator_type = Allocator;
 
 	// ============= Iterator ============= //
 	
@@ -37,9 +123,10 @@ public:
 		using base_node_pointer = std::conditional_t<isConst, const BaseNode*, BaseNode*>;
 		using node_pointer = std::conditional_t<isConst, const Node*, Node*>;
 
+		list_iterator() noexcept = default;
 		explicit list_iterator(base_node_pointer node) noexcept: base_node_(node) {}
 		
-		reference dereference() noexcept { return static_cast<node_pointer>(base_node_)->value_; }
+		reference dereference() const noexcept { return static_cast<node_pointer>(base_node_)->value_; }
 		void increment() noexcept { base_node_ = base_node_->next_; }
 		void decrement() noexcept { base_node_ = base_node_->prev_; }
 
@@ -62,9 +149,10 @@ public:
 		using base_node_pointer = std::conditional_t<isConst, const BaseNode*, BaseNode*>;
 		using node_pointer = std::conditional_t<isConst, const Node*, Node*>;
 
+		reverse_list_iterator() noexcept = default;
 		explicit reverse_list_iterator(base_node_pointer node) noexcept: base_node_(node) {}
 		
-		reference dereference() noexcept { return static_cast<node_pointer>(base_node_)->value_; }
+		reference dereference() const noexcept { return static_cast<node_pointer>(base_node_)->value_; }
 		void increment() noexcept { base_node_ = base_node_->prev_; }
 		void decrement() noexcept { base_node_ = base_node_->next_; }
 
@@ -80,15 +168,13 @@ public:
 	using reverse_iterator = reverse_list_iterator<false>;
 	using const_reverse_iterator = reverse_list_iterator<true>;
 
-	struct BaseNode {
-		BaseNode* next_ = nullptr;
-		BaseNode* prev_ = nullptr;
-	};
-
 	class Node: public BaseNode {
 		friend list;
-		friend iterator;
+		template<bool> friend class list_iterator;
+		template<bool> friend class reverse_list_iterator;
 	public:
+		using payload_type = T;
+
 		template<typename U> 
 		Node(U&& val):value_(std::forward<U>(val)) {}
 
@@ -104,6 +190,56 @@ public:
 		T value_;
 	};
 
+private:
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+public:
+
+	// Owns one element taken out of a list by extract(), like the node handles of
+	// std::map. insert() links it into a list with an equal allocator without
+	// allocating; a handle that still holds its node destroys it.
+	class node_handle {
+		friend list;
+	public:
+		using value_type = T;
+		using allocator_type = Allocator;
+
+		node_handle() noexcept = default;
+		node_handle(node_handle&& other) noexcept: node_(std::exchange(other.node_, nullptr)), alloc_(std::move(other.alloc_)) {}
+
+		node_handle& operator=(node_handle&& other) noexcept {
+			if(this != &other) {
+				reset();
+				node_ = std::exchange(other.node_, nullptr);
+				alloc_ = std::move(other.alloc_);
+			}
+			return *this;
+		}
+
+		~node_handle() { reset(); }
+
+		bool empty() const noexcept { return node_ == nullptr; }
+		explicit operator bool() const noexcept { return node_ != nullptr; }
+
+		T& value() const noexcept { return node_->value_; }
+		allocator_type get_allocator() const { return allocator_type(*alloc_); }
+	private:
+		node_handle(Node* node, const node_allocator& alloc) noexcept: node_(node), alloc_(alloc) {}
+
+		void reset() noexcept {
+			if(node_) {
+				node_traits::destroy(*alloc_, node_);
+				node_traits::deallocate(*alloc_, node_, 1);
+				node_ = nullptr;
+			}
+		}
+
+		Node* node_ = nullptr;
+		std::optional<node_allocator> alloc_;
+	};
+
+	using node_type = node_handle;
+
 	iterator begin() noexcept { return iterator(begin_.next_); }
 	const_iterator begin() const noexcept { return cbegin(); }
 	const_iterator cbegin() const noexcept { return const_iterator(begin_.next_); }
@@ -120,7 +256,9 @@ public:
 	const_reverse_iterator rend() const noexcept { return crend(); }
 	const_reverse_iterator crend() const noexcept { return const_reverse_iterator(); }
 
-	list() {
+	list(): list(Allocator()) {}
+
+	explicit list(const Allocator& alloc): alloc_(alloc) {
 		begin_.next_ = &begin_;
 		begin_.prev_ = &begin_;
 		// std::cout << "IS BASE OF: " << std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<decltype(begin())>::iterator_category> << std::endl;
@@ -129,89 +267,191 @@ public:
 
 	list(size_t n): list() {
 		static_assert(DefaultConstructible<T>, "T isn't default constructible");
-		size_t idx{};
-		try
-		{
-			while(idx < n) {
-				push_back({}); //TODO rewrite to emplace
-				++idx;
-			}
+		emplace_back_n(n);
+	}
+
+	list(size_t n, const T& val): list() {
+		insert(end(), n, val);
+	}
+
+	list(std::initializer_list<T> init_list, const Allocator& alloc = Allocator()): list(alloc) {
+		append_range(init_list);
+	}
+
+	template<std::input_iterator It>
+	list(It begin, It end): list() {
+		insert(this->end(), begin, end);
+	}
+
+	list(const list& other): list(Allocator(node_traits::select_on_container_copy_construction(other.alloc_))) {
+		append_range(other);
+	}
+	list(list&& other) noexcept: alloc_(other.alloc_) {
+		begin_.next_ = &begin_;
+		begin_.prev_ = &begin_;
+		stealFrom(other);
+	}
+
+	// ============= Assignment ============= //
+	// Existing nodes are assigned over and only the difference in length is
+	// allocated or freed, so rebuilding a list from another of similar size does
+	// not go through the allocator.
+
+	list& operator=(const list& other) {
+		if(this == &other) {
+			return *this;
 		}
-		catch(const std::exception&)
-		{
-			std::cout << "e" << std::endl;
-			while(idx > 0) {
-				pop_back();
-				--idx;
+		if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+			if(alloc_ != other.alloc_) {
+				clear();
 			}
+			alloc_ = other.alloc_;
 		}
+		assign(other.begin(), other.end());
+		return *this;
 	}
 
-	//TODO write list unwind for strong exception garantee
-	list(std::initializer_list<T> init_list): list() {
-		size_t idx{};
-		try
-		{
-			for(const auto& el : init_list) {
-				push_back(el);
-				++idx;
-			}
+	// Takes other's nodes when the allocators allow it, else moves element by
+	// element into the existing nodes.
+	list& operator=(list&& other) noexcept(node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value) {
+		if(this == &other) {
+			return *this;
 		}
-		catch(const std::exception&)
-		{
-			std::cout << "e" << std::endl;
-			while(idx > 0) {
-				pop_back();
-				--idx;
+		if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+			clear();
+			alloc_ = other.alloc_;
+			stealFrom(other);
+		} else {
+			if(alloc_ == other.alloc_) {
+				clear();
+				stealFrom(other);
+			} else {
+				assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
 			}
 		}
+		return *this;
 	}
 
-	// template<std::input_iterator It> //TODO Fix candidate template ignored: constraints not satisfied
-	template<typename It>
-	list(It begin, It end): list() { //TODO write list unwind for strong exception garantee
-		while(begin != end) {
-			push_back(*begin);
-			++begin;
-		}
+	list& operator=(std::initializer_list<T> init_list) {
+		assign(init_list.begin(), init_list.end());
+		return *this;
 	}
 
-	list(const list& other): list(other.begin(), other.end()) {}
-	list(list&& other) noexcept: begin_(other.begin_) {}
+	template<std::input_iterator It, std::sentinel_for<It> Sent>
+	void assign(It first, Sent last) {
+		EXP_TRACE_SCOPE("exp::list::assign");
+		iterator it = begin();
+		for(; it != end() && first != last; ++it, ++first) {
+			*it = *first;
+		}
+		if(first == last) {
+			erase(it, end());
+		} else {
+			insert(end(), std::move(first), std::move(last));
+		}
+	}
 
-	// list& operator=(const list& other) {
-	//     if(*this == &other) return *this;
+	void assign(size_t n, const T& val) {
+		iterator it = begin();
+		for(; it != end() && n != 0; ++it, --n) {
+			*it = val;
+		}
+		if(n == 0) {
+			erase(it, end());
+		} else {
+			insert(end(), n, val);
+		}
+	}
 
-	//     auto begin = other.size() > size() ? other.begin() : begin(); 
+	void assign(std::initializer_list<T> init_list) { assign(init_list.begin(), init_list.end()); }
 
-	//     return *this;
-	// }
+	~list() { clear(); }
 
-	~list() {
-		auto it = begin();
-		auto end_it = end();
-		while(it != end_it) {
-			auto* curr_node =  static_cast<Node*>(it.base_node_);
-			++it;
-			delete curr_node;
+	void clear() noexcept {
+		BaseNode* curr = begin_.next_;
+		while(curr != &begin_) {
+			BaseNode* next = curr->next_;
+			destroyNode(static_cast<Node*>(curr));
+			curr = next;
 		}
+		begin_.next_ = &begin_;
+		begin_.prev_ = &begin_;
+		size_ = 0;
 	}
 
 	iterator insert(iterator pos, const T& val) { //insert before
-		Node* new_node = new Node(val);
+		Node* new_node = createNode(val);
+
+		return insertNodeImpl(pos, new_node);
+	}
+
+	iterator insert(iterator pos, T&& val) {
+		Node* new_node = createNode(std::move(val));
 
 		return insertNodeImpl(pos, new_node);
 	}
 
 	template<typename... Args>
 	iterator emplace(iterator pos, Args&&... args) {
-		Node* new_node = new Node(std::forward<Args>(args)...);
+		Node* new_node = createNode(std::forward<Args>(args)...);
 
 		return insertNodeImpl(pos, new_node);
 	}
 
+	// ============= Bulk insertion ============= //
+	// New nodes are built as a detached prelinked chain, taken from a single
+	// allocate_bulk() block when the allocator offers one, and linked in front of
+	// pos with O(1) pointer updates. If any element throws, the chain is destroyed
+	// and the list is left untouched.
+
+	iterator insert(iterator pos, size_t n, const T& val) {
+		NodeChain chain = createChain(n, [this, &val](Node* node) { node_traits::construct(alloc_, node, val); });
+		return insertChain(pos, chain);
+	}
+
+	template<std::input_iterator It, std::sentinel_for<It> Sent>
+	iterator insert(iterator pos, It first, Sent last) {
+		if constexpr (std::forward_iterator<It>) {
+			const auto count = static_cast<size_t>(std::ranges::distance(first, last));
+			NodeChain chain = createChain(count, [this, &first](Node* node) {
+				node_traits::construct(alloc_, node, *first);
+				++first;
+			});
+			return insertChain(pos, chain);
+		} else {
+			NodeChain chain;
+			try {
+				for(; first != last; ++first) {
+					chainAppend(chain, createNode(*first));
+				}
+			} catch(...) {
+				destroyChain(chain);
+				throw;
+			}
+			return insertChain(pos, chain);
+		}
+	}
+
+	iterator insert(iterator pos, std::initializer_list<T> init_list) {
+		return insert(pos, init_list.begin(), init_list.end());
+	}
+
+	template<std::ranges::input_range R>
+	void append_range(R&& range) {
+		insert(end(), std::ranges::begin(range), std::ranges::end(range));
+	}
+
+	// Appends n elements, each constructed from args.
+	template<typename... Args>
+	iterator emplace_back_n(size_t n, const Args&... args) {
+		NodeChain chain = createChain(n, [this, &args...](Node* node) { node_traits::construct(alloc_, node, args...); });
+		return insertChain(end(), chain);
+	}
+
 	size_t size() const noexcept { return size_; }
 
+	allocator_type get_allocator() const { return allocator_type(alloc_); }
+
 	void push_back(const T& val) { insert(end(), val); }
 	void push_back(T&& val) { insert(end(), std::move(val)); }
 
@@ -237,7 +477,14 @@ public:
 		}
 		--size_;
 
-		delete static_cast<Node*>(pos.base_node_);
+		destroyNode(static_cast<Node*>(pos.base_node_));
+	}
+
+	iterator erase(iterator first, iterator last) noexcept {
+		while(first != last) {
+			erase(first++);
+		}
+		return last;
 	}
 
 	void pop_back() noexcept {
@@ -247,6 +494,238 @@ public:
 		erase(begin());
 	}
 
+	// Unlinks the element at pos without destroying it. An element stored inline
+	// is first moved to a heap node, which may throw, so the handle never points
+	// into the list object.
+	node_type extract(iterator pos) {
+		auto* node = static_cast<Node*>(pos.base_node_);
+		if(inline_.owns(node)) {
+			Node* heap_node = node_traits::allocate(alloc_, 1);
+			relocateNode(node, heap_node);
+			inline_.give(node);
+			node = heap_node;
+		}
+		BaseNode* base = node->asBase();
+		base->prev_->next_ = base->next_;
+		base->next_->prev_ = base->prev_;
+		--size_;
+		return node_type(node, alloc_);
+	}
+
+	// Links the element of handle before pos, end() if the handle is empty.
+	iterator insert(iterator pos, node_type&& handle) noexcept {
+		if(handle.empty()) {
+			return end();
+		}
+		assert(*handle.alloc_ == alloc_ && "node handle from a list with another allocator");
+		return insertNodeImpl(pos, std::exchange(handle.node_, nullptr));
+	}
+
+	// ============= Operations ============= //
+	// Everything below relinks nodes only: no element is copied or moved and
+	// nothing is allocated. Lists passed in must use an equal allocator, debug
+	// builds assert it.
+	// With InlineNodes > 0, nodes taken from another list's inline buffer are the
+	// exception: they are moved into this list's buffer, or to the heap once it
+	// is full, so those overloads may throw std::bad_alloc, leaving both lists
+	// untouched.
+
+	void splice(iterator pos, list& other) noexcept(InlineNodes == 0) {
+		if(other.size_ == 0 || this == &other) {
+			return;
+		}
+		assert(alloc_ == other.alloc_ && "splice from a list with another allocator");
+		NodeReserve reserve(*this, other.inline_.used());
+		transferRange(pos.base_node_, other.begin_.next_, &other.begin_);
+		size_ += std::exchange(other.size_, 0);
+		other.inline_.for_each_used([&](Node* node) { adoptNode(other, node, reserve); });
+	}
+	void splice(iterator pos, list&& other) noexcept(InlineNodes == 0) { splice(pos, other); }
+
+	void splice(iterator pos, list& other, iterator it) noexcept(InlineNodes == 0) {
+		assert(alloc_ == other.alloc_ && "splice from a list with another allocator");
+		BaseNode* node = it.base_node_;
+		if(node == pos.base_node_ || node->next_ == pos.base_node_) {
+			return;
+		}
+		const bool adopt = this != &other && other.inline_.owns(node);
+		NodeReserve reserve(*this, adopt ? 1 : 0);
+		transferRange(pos.base_node_, node, node->next_);
+		--other.size_;
+		++size_;
+		if(adopt) {
+			adoptNode(other, static_cast<Node*>(node), reserve);
+		}
+	}
+	void splice(iterator pos, list&& other, iterator it) noexcept(InlineNodes == 0) { splice(pos, other, it); }
+
+	// Linear in the length of [first, last) when other is another list, to keep size() O(1).
+	void splice(iterator pos, list& other, iterator first, iterator last) noexcept(InlineNodes == 0) {
+		const size_t count = this == &other ? 0 : static_cast<size_t>(std::distance(first, last));
+		splice(pos, other, first, last, count);
+	}
+	void splice(iterator pos, list&& other, iterator first, iterator last) noexcept(InlineNodes == 0) { splice(pos, other, first, last); }
+
+	// O(1) range splice, count must be the length of [first, last). Linear when
+	// other has inline nodes, the range is scanned for them.
+	void splice(iterator pos, list& other, iterator first, iterator last, size_t count) noexcept(InlineNodes == 0) {
+		if(first == last) {
+			return;
+		}
+		assert(alloc_ == other.alloc_ && "splice from a list with another allocator");
+		size_t adopted{};
+		if(this != &other && other.inline_.used() != 0) {
+			for(BaseNode* node = first.base_node_; node != last.base_node_; node = node->next_) {
+				adopted += other.inline_.owns(node) ? 1 : 0;
+			}
+		}
+		NodeReserve reserve(*this, adopted);
+		transferRange(pos.base_node_, first.base_node_, last.base_node_);
+		if(this != &other) {
+			other.size_ -= count;
+			size_ += count;
+		}
+		if(adopted != 0) {
+			adoptRange(other, first.base_node_, pos.base_node_, reserve);
+		}
+	}
+
+	// Merges sorted other into this sorted list, equal elements of this list go first.
+	template<typename Compare = std::less<>>
+	void merge(list& other, Compare comp = {}) {
+		EXP_TRACE_SCOPE("exp::list::merge");
+		if(this == &other) {
+			return;
+		}
+		assert(alloc_ == other.alloc_ && "merge with a list with another allocator");
+		if constexpr (InlineNodes == 0) {
+			mergeNodes(other, comp);
+		} else {
+			NodeReserve reserve(*this, other.inline_.used());
+			try {
+				mergeNodes(other, comp);
+			} catch(...) {
+				adoptRange(other, begin_.next_, &begin_, reserve);
+				throw;
+			}
+			adoptRange(other, begin_.next_, &begin_, reserve);
+		}
+	}
+	template<typename Compare = std::less<>>
+	void merge(list&& other, Compare comp = {}) { merge(other, comp); }
+
+	// Stable bottom-up merge sort. The ring is opened into a singly linked chain,
+	// runs of 2^i nodes are kept in bins and merged through next_ only, prev_ links
+	// are restored in one final pass. If comp throws, every element stays in the
+	// list in unspecified order.
+	template<typename Compare = std::less<>>
+	void sort(Compare comp = {}) {
+		EXP_TRACE_SCOPE("exp::list::sort");
+		if(size_ < 2) {
+			return;
+		}
+		constexpr size_t max_bins = 64;
+		BaseNode* bins[max_bins] = {};
+		BaseNode* carry = nullptr;
+
+		begin_.prev_->next_ = nullptr;
+		BaseNode* head = begin_.next_;
+		try {
+			while(head) {
+				carry = head;
+				head = head->next_;
+				carry->next_ = nullptr;
+
+				size_t idx = 0;
+				for(; idx < max_bins - 1 && bins[idx]; ++idx) {
+					BaseNode* run = std::exchange(carry, nullptr);
+					mergeRuns(bins[idx], run, comp);
+					carry = std::exchange(bins[idx], nullptr);
+				}
+				bins[idx] = std::exchange(carry, nullptr);
+			}
+
+			BaseNode* result = nullptr;
+			for(size_t idx = 0; idx < max_bins; ++idx) {
+				if(bins[idx]) {
+					BaseNode* run = std::exchange(result, nullptr);
+					mergeRuns(bins[idx], run, comp);
+					result = std::exchange(bins[idx], nullptr);
+				}
+			}
+			relinkChain(result);
+		} catch(...) {
+			BaseNode* chain = concatChains(carry, head);
+			for(auto* bin : bins) {
+				chain = concatChains(bin, chain);
+			}
+			relinkChain(chain);
+			throw;
+		}
+	}
+
+	void reverse() noexcept {
+		BaseNode* curr = &begin_;
+		do {
+			std::swap(curr->next_, curr->prev_);
+			curr = curr->prev_;
+		} while(curr != &begin_);
+	}
+
+	// Erases all but the first element of every group of consecutive equal elements.
+	template<typename BinaryPredicate = std::equal_to<>>
+	size_t unique(BinaryPredicate pred = {}) {
+		EXP_TRACE_SCOPE("exp::list::unique");
+		size_t removed{};
+		if(size_ < 2) {
+			return removed;
+		}
+		BaseNode* first = begin_.next_;
+		BaseNode* next = first->next_;
+		while(next != &begin_) {
+			BaseNode* after = next->next_;
+			if(pred(valueOf(first), valueOf(next))) {
+				erase(iterator(next));
+				++removed;
+			} else {
+				first = next;
+			}
+			next = after;
+		}
+		return removed;
+	}
+
+	// Exchanges the linked nodes in O(1), only the inline ones are moved.
+	void swap(list& other) noexcept {
+		if(this == &other) {
+			return;
+		}
+		BaseNode ring;
+		ring.next_ = &ring;
+		ring.prev_ = &ring;
+		if(size_ != 0) {
+			transferRange(&ring, begin_.next_, &begin_);
+		}
+		if(other.size_ != 0) {
+			transferRange(&begin_, other.begin_.next_, &other.begin_);
+		}
+		if(ring.next_ != &ring) {
+			transferRange(&other.begin_, ring.next_, &ring);
+		}
+		std::swap(size_, other.size_);
+		using std::swap;
+		swap(alloc_, other.alloc_);
+
+		// Each list now holds nodes from the other's buffer, so they go round
+		// through a third one.
+		details::inline_nodes<Node, InlineNodes> spare;
+		moveInlineNodes(other.inline_, spare);
+		moveInlineNodes(inline_, other.inline_);
+		moveInlineNodes(spare, inline_);
+	}
+
+	friend void swap(list& lhs, list& rhs) noexcept { lhs.swap(rhs); }
+
 	friend std::ostream& operator<<(std::ostream& os, const list& list) {
 		for(const auto& el : list) {
 			os << el << ' ';
@@ -262,6 +741,124 @@ public:
 	}
 
 private:
+	Node* allocateNode() {
+		if(Node* node = inline_.take()) {
+			return node;
+		}
+		return node_traits::allocate(alloc_, 1);
+	}
+
+	void deallocateNode(Node* node) noexcept {
+		if(inline_.owns(node)) {
+			inline_.give(node);
+		} else {
+			node_traits::deallocate(alloc_, node, 1);
+		}
+	}
+
+	template<typename... Args>
+	Node* createNode(Args&&... args) {
+		Node* node = allocateNode();
+		try {
+			node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+		} catch(...) {
+			deallocateNode(node);
+			throw;
+		}
+		return node;
+	}
+
+	void destroyNode(Node* node) noexcept {
+		node_traits::destroy(alloc_, node);
+		deallocateNode(node);
+	}
+
+	// Null-terminated run of nodes not yet owned by the list.
+	struct NodeChain {
+		BaseNode* first_ = nullptr;
+		BaseNode* last_ = nullptr;
+		size_t size_{};
+	};
+
+	static void chainAppend(NodeChain& chain, Node* node) noexcept {
+		BaseNode* base = node->asBase();
+		base->prev_ = chain.last_;
+		base->next_ = nullptr;
+		if(chain.last_) {
+			chain.last_->next_ = base;
+		} else {
+			chain.first_ = base;
+		}
+		chain.last_ = base;
+		++chain.size_;
+	}
+
+	void destroyChain(NodeChain& chain) noexcept {
+		BaseNode* curr = chain.first_;
+		while(curr) {
+			BaseNode* next = curr->next_;
+			destroyNode(static_cast<Node*>(curr));
+			curr = next;
+		}
+		chain = {};
+	}
+
+	// Builds count nodes, construct(node) placing an element into each of them.
+	template<typename Construct>
+	NodeChain createChain(size_t count, Construct&& construct) {
+		EXP_TRACE_SCOPE("exp::list::create_chain");
+		NodeChain chain;
+		if(count == 0) {
+			return chain;
+		}
+		// Free inline slots are used first, the rest comes from the allocator.
+		const size_t inline_count = std::min(count, inline_.available());
+		Node* block = nullptr;
+		if constexpr (requires { alloc_.allocate_bulk(count); }) {
+			if(count > inline_count) {
+				block = alloc_.allocate_bulk(count - inline_count);
+			}
+		}
+		size_t idx{};
+		try {
+			for(; idx < count; ++idx) {
+				const bool from_block = block && idx >= inline_count;
+				Node* node = from_block ? block + (idx - inline_count) : allocateNode();
+				try {
+					construct(node);
+				} catch(...) {
+					if(!from_block) {
+						deallocateNode(node);
+					}
+					throw;
+				}
+				chainAppend(chain, node);
+			}
+		} catch(...) {
+			destroyChain(chain);
+			for(idx = std::max(idx, inline_count); block && idx < count; ++idx) {
+				node_traits::deallocate(alloc_, block + (idx - inline_count), 1);
+			}
+			throw;
+		}
+		return chain;
+	}
+
+	// Links the whole chain in front of pos.
+	iterator insertChain(iterator pos, NodeChain& chain) noexcept {
+		if(!chain.first_) {
+			return pos;
+		}
+		BaseNode* next = pos.base_node_;
+		BaseNode* prev = next->prev_;
+		prev->next_ = chain.first_;
+		chain.first_->prev_ = prev;
+		chain.last_->next_ = next;
+		next->prev_ = chain.last_;
+		size_ += chain.size_;
+		return iterator(std::exchange(chain, {}).first_);
+	}
+
 	void linkNodeTo(BaseNode* new_node, BaseNode* curr) noexcept {
 		BaseNode* prev = curr->prev_;
 
@@ -274,6 +871,195 @@ private:
 		}
 	}
 
+	template<typename Compare>
+	void mergeNodes(list& other, Compare& comp) {
+		BaseNode* first1 = begin_.next_;
+		BaseNode* first2 = other.begin_.next_;
+		while(first1 != &begin_ && first2 != &other.begin_) {
+			if(comp(valueOf(first2), valueOf(first1))) {
+				BaseNode* run_end = first2->next_;
+				while(run_end != &other.begin_ && comp(valueOf(run_end), valueOf(first1))) {
+					run_end = run_end->next_;
+				}
+				const size_t moved = countRange(first2, run_end);
+				transferRange(first1, first2, run_end);
+				other.size_ -= moved;
+				size_ += moved;
+				first2 = run_end;
+			} else {
+				first1 = first1->next_;
+			}
+		}
+		if(first2 != &other.begin_) {
+			transferRange(&begin_, first2, &other.begin_);
+			size_ += std::exchange(other.size_, 0);
+		}
+	}
+
+	// ============= Inline nodes ============= //
+
+	// Storage set aside before nodes are taken over from another list's inline
+	// buffer: free inline slots, then heap nodes for the rest. Moving the nodes
+	// over afterwards cannot fail halfway. Unused heap nodes are released.
+	class NodeReserve {
+	public:
+		NodeReserve(list& owner, size_t count): owner_(owner) {
+			const size_t slots = owner_.inline_.available();
+			try {
+				for(; count > slots + heap_; ++heap_) {
+					nodes_[heap_] = node_traits::allocate(owner_.alloc_, 1);
+				}
+			} catch(...) {
+				release();
+				throw;
+			}
+		}
+		NodeReserve(const NodeReserve&) = delete;
+		NodeReserve& operator=(const NodeReserve&) = delete;
+		~NodeReserve() { release(); }
+
+		Node* take() noexcept {
+			if(Node* node = owner_.inline_.take()) {
+				return node;
+			}
+			return nodes_[--heap_];
+		}
+	private:
+		void release() noexcept {
+			while(heap_ != 0) {
+				node_traits::deallocate(owner_.alloc_, nodes_[--heap_], 1);
+			}
+		}
+
+		list& owner_;
+		Node* nodes_[InlineNodes == 0 ? 1 : InlineNodes];
+		size_t heap_{};
+	};
+
+	// Moves the element of old into storage node, which takes its place in the ring.
+	void relocateNode(Node* old, Node* node) noexcept {
+		node_traits::construct(alloc_, node, std::move(old->value_));
+		BaseNode* base = node->asBase();
+		base->prev_ = old->prev_;
+		base->next_ = old->next_;
+		base->prev_->next_ = base;
+		base->next_->prev_ = base;
+		node_traits::destroy(alloc_, old);
+	}
+
+	// Every node stored in from goes to a slot of to, which must have room for them.
+	void moveInlineNodes(details::inline_nodes<Node, InlineNodes>& from, details::inline_nodes<Node, InlineNodes>& to) noexcept {
+		from.for_each_used([&](Node* old) {
+			relocateNode(old, to.take());
+			from.give(old);
+		});
+	}
+
+	// old, now linked into this list, is still stored in from's inline buffer.
+	void adoptNode(list& from, Node* old, NodeReserve& reserve) noexcept {
+		relocateNode(old, reserve.take());
+		from.inline_.give(old);
+	}
+
+	void adoptRange(list& from, BaseNode* first, BaseNode* last, NodeReserve& reserve) noexcept {
+		while(first != last) {
+			BaseNode* next = first->next_;
+			if(from.inline_.owns(first)) {
+				adoptNode(from, static_cast<Node*>(first), reserve);
+			}
+			first = next;
+		}
+	}
+
+	// Takes over all nodes of other, this list must be empty. Its inline buffer is
+	// then free, so other's inline nodes fit without allocating.
+	void stealFrom(list& other) noexcept {
+		if(other.size_ == 0) {
+			return;
+		}
+		transferRange(&begin_, other.begin_.next_, &other.begin_);
+		size_ = std::exchange(other.size_, 0);
+		moveInlineNodes(other.inline_, inline_);
+	}
+
+	static T& valueOf(BaseNode* node) noexcept { return static_cast<Node*>(node)->value_; }
+
+	static size_t countRange(BaseNode* first, BaseNode* last) noexcept {
+		size_t count{};
+		for(; first != last; first = first->next_) {
+			++count;
+		}
+		return count;
+	}
+
+	// Moves [first, last) in front of pos.
+	static void transferRange(BaseNode* pos, BaseNode* first, BaseNode* last) noexcept {
+		if(pos == last) {
+			return;
+		}
+		BaseNode* last_node = last->prev_;
+
+		first->prev_->next_ = last;
+		last->prev_ = first->prev_;
+
+		BaseNode* prev = pos->prev_;
+		prev->next_ = first;
+		first->prev_ = prev;
+		last_node->next_ = pos;
+		pos->prev_ = last_node;
+	}
+
+	// Merges null-terminated run rhs into null-terminated run lhs through next_ only.
+	// If comp throws, lhs holds every node of both runs.
+	template<typename Compare>
+	static void mergeRuns(BaseNode*& lhs, BaseNode* rhs, Compare& comp) {
+		BaseNode head;
+		BaseNode* tail = &head;
+		BaseNode* left = lhs;
+		try {
+			while(left && rhs) {
+				if(comp(valueOf(rhs), valueOf(left))) {
+					tail->next_ = rhs;
+					rhs = rhs->next_;
+				} else {
+					tail->next_ = left;
+					left = left->next_;
+				}
+				tail = tail->next_;
+			}
+		} catch(...) {
+			tail->next_ = left;
+			lhs = concatChains(head.next_, rhs);
+			throw;
+		}
+		tail->next_ = left ? left : rhs;
+		lhs = head.next_;
+	}
+
+	static BaseNode* concatChains(BaseNode* first, BaseNode* second) noexcept {
+		if(!first) {
+			return second;
+		}
+		BaseNode* tail = first;
+		while(tail->next_) {
+			tail = tail->next_;
+		}
+		tail->next_ = second;
+		return first;
+	}
+
+	// Hooks a null-terminated chain back into the ring, restoring prev_ links.
+	void relinkChain(BaseNode* chain) noexcept {
+		BaseNode* prev = &begin_;
+		for(BaseNode* curr = chain; curr; curr = curr->next_) {
+			prev->next_ = curr;
+			curr->prev_ = prev;
+			prev = curr;
+		}
+		prev->next_ = &begin_;
+		begin_.prev_ = prev;
+	}
+
 	iterator insertNodeImpl(iterator pos, Node* node) noexcept {
 		BaseNode* new_base_node = node->asBase();
 
@@ -286,8 +1072,14 @@ private:
 
 	BaseNode begin_;
 	size_t size_{};
+	[[no_unique_address]] node_allocator alloc_;
+	[[no_unique_address]] details::inline_nodes<Node, InlineNodes> inline_;
 };
 
+// List keeping its first N nodes inline, for the many lists that stay short.
+template<typename T, size_t N = 8, typename Allocator = default_allocator<T>>
+using small_list = list<T, Allocator, N>;
+
 template<typename T>
 list(std::initializer_list<T>) -> list<T>;
 
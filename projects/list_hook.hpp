@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+
+namespace exp {
+
+// Links of a circular doubly linked list. exp::list embeds one in every node,
+// intrusive_list expects it as a member of the user type.
+struct list_hook {
+	list_hook* next_ = nullptr;
+	list_hook* prev_ = nullptr;
+
+	// Only meaningful for hooks owned by an intrusive_list, which clears them on unlink.
+	bool is_linked() const noexcept { return next_ != nullptr; }
+};
+
+} // namespace exp
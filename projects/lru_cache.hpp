@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "allocation_stats.hpp"
+#include "list.hpp"
+#include "prng.hpp"
+
+namespace exp {
+
+// Default weigher of lru_cache: every entry counts as one, capacity is in entries.
+struct unit_weight {
+	template<typename Key, typename Value>
+	constexpr std::size_t operator()(const Key&, const Value&) const noexcept { return 1; }
+};
+
+struct cache_stats {
+	std::uint64_t hits_ = 0;
+	std::uint64_t misses_ = 0;
+	std::uint64_t evictions_ = 0;
+};
+
+// Least recently used cache. Entries live in an exp::list ordered from most to
+// least recently used, an open-addressed index maps keys to their list nodes.
+// A hit splices the node to the front; a miss that has to evict reuses the
+// evicted node through extract()/insert(), so in steady state neither goes
+// through the allocator.
+//
+// Capacity is measured by Weigher(key, value): one per entry by default, or
+// bytes with a weigher such as
+//     [](const std::string& key, const std::string& value) { return key.size() + value.size(); }
+// Not thread safe.
+template<typename Key, typename Value, typename Weigher = unit_weight, typename Hash = std::hash<Key>,
+	typename KeyEqual = std::equal_to<Key>, typename Allocator = default_allocator<Value>>
+class lru_cache {
+	struct Entry {
+		Key key_;
+		Value value_;
+		std::size_t weight_;
+		std::size_t hash_;
+	};
+
+	using entry_list = list<Entry, typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>>;
+	using entry_iterator = typename entry_list::iterator;
+	using node_type = typename entry_list::node_type;
+
+	// An empty slot holds a default constructed iterator.
+	struct Slot {
+		entry_iterator entry_{};
+		std::size_t hash_ = 0;
+	};
+public:
+	using key_type = Key;
+	using mapped_type = Value;
+
+	explicit lru_cache(std::size_t capacity, const Weigher& weigher = Weigher(), const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator()):
+		entries_(typename entry_list::allocator_type(alloc)),
+		slots_(initial_slots),
+		capacity_(capacity),
+		weigher_(weigher),
+		hash_(hash),
+		equal_(equal)
+	{}
+
+	// The index holds iterators into entries_.
+	lru_cache(const lru_cache&) = delete;
+	lru_cache& operator=(const lru_cache&) = delete;
+
+	// ============= Lookup ============= //
+
+	// Makes the entry the most recently used one. The pointer stays valid until
+	// the next call that modifies the cache.
+	Value* get(const Key& key) {
+		const std::size_t slot = findSlot(hashOf(key), key);
+		if(slot == npos) {
+			++stats_.misses_;
+			return nullptr;
+		}
+		++stats_.hits_;
+		entry_iterator entry = slots_[slot].entry_;
+		entries_.splice(entries_.begin(), entries_, entry);
+		return &entry->value_;
+	}
+
+	// Neither changes the recency order nor counts as a hit or miss.
+	const Value* peek(const Key& key) const {
+		const std::size_t slot = findSlot(hashOf(key), key);
+		return slot == npos ? nullptr : &slots_[slot].entry_->value_;
+	}
+
+	bool contains(const Key& key) const { return peek(key) != nullptr; }
+
+	// Calls func(key, value) from the most to the least recently used entry.
+	template<typename F>
+	void for_each(F&& func) const {
+		for(const Entry& entry : entries_) {
+			std::invoke(func, std::as_const(entry.key_), std::as_const(entry.value_));
+		}
+	}
+
+	// ============= Modifiers ============= //
+
+	// Inserts or replaces the value of key as the most recently used entry and
+	// evicts from the back until it fits. An entry heavier than the whole
+	// capacity is not stored, a previous value of key is dropped then.
+	template<typename V>
+	bool put(const Key& key, V&& value) {
+		const std::size_t weight = weigher_(key, std::as_const(value));
+		const std::size_t hash = hashOf(key);
+		const std::size_t slot = findSlot(hash, key);
+		if(slot != npos) {
+			entry_iterator entry = slots_[slot].entry_;
+			if(weight > capacity_) {
+				eraseEntry(slot);
+				return false;
+			}
+			entry->value_ = std::forward<V>(value);
+			weight_ = weight_ - entry->weight_ + weight;
+			entry->weight_ = weight;
+			entries_.splice(entries_.begin(), entries_, entry);
+			evictTo(capacity_);
+			return true;
+		}
+		if(weight > capacity_) {
+			return false;
+		}
+
+		reserveSlot();
+		node_type spare;
+		while(weight_ + weight > capacity_) {
+			spare = evictBack();
+		}
+		if(spare) {
+			Entry& entry = spare.value();
+			entry.key_ = key;
+			entry.value_ = std::forward<V>(value);
+			entry.weight_ = weight;
+			entry.hash_ = hash;
+			entries_.insert(entries_.begin(), std::move(spare));
+		} else {
+			entries_.emplace_front(Entry{key, std::forward<V>(value), weight, hash});
+		}
+		insertSlot(hash, entries_.begin());
+		weight_ += weight;
+		return true;
+	}
+
+	bool erase(const Key& key) {
+		const std::size_t slot = findSlot(hashOf(key), key);
+		if(slot == npos) {
+			return false;
+		}
+		eraseEntry(slot);
+		return true;
+	}
+
+	void clear() noexcept {
+		entries_.clear();
+		std::fill(slots_.begin(), slots_.end(), Slot{});
+		weight_ = 0;
+	}
+
+	// Evicts least recently used entries until the cache fits the new capacity.
+	void set_capacity(std::size_t capacity) {
+		capacity_ = capacity;
+		evictTo(capacity_);
+	}
+
+	// ============= Capacity ============= //
+
+	std::size_t size() const noexcept { return entries_.size(); }
+	bool empty() const noexcept { return entries_.size() == 0; }
+	std::size_t weight() const noexcept { return weight_; }
+	std::size_t capacity() const noexcept { return capacity_; }
+
+	const cache_stats& stats() const noexcept { return stats_; }
+	void reset_stats() noexcept { stats_ = cache_stats{}; }
+
+private:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr std::size_t initial_slots = 16;
+
+	std::size_t hashOf(const Key& key) const {
+		return static_cast<std::size_t>(mix64(static_cast<std::uint64_t>(hash_(key))));
+	}
+
+	std::size_t mask() const noexcept { return slots_.size() - 1; }
+
+	std::size_t findSlot(std::size_t hash, const Key& key) const {
+		for(std::size_t idx = hash & mask();; idx = (idx + 1) & mask()) {
+			const Slot& slot = slots_[idx];
+			if(slot.entry_ == entry_iterator{}) {
+				return npos;
+			}
+			if(slot.hash_ == hash && equal_(slot.entry_->key_, key)) {
+				return idx;
+			}
+		}
+	}
+
+	std::size_t slotOf(entry_iterator entry) const noexcept {
+		std::size_t idx = entry->hash_ & mask();
+		while(slots_[idx].entry_ != entry) {
+			idx = (idx + 1) & mask();
+		}
+		return idx;
+	}
+
+	// Keeps the load factor at or below one half, so probe runs stay short.
+	void reserveSlot() {
+		if((entries_.size() + 1) * 2 <= slots_.size()) {
+			return;
+		}
+		std::vector<Slot> old(slots_.size() * 2);
+		old.swap(slots_);
+		for(const Slot& slot : old) {
+			if(slot.entry_ != entry_iterator{}) {
+				insertSlot(slot.hash_, slot.entry_);
+			}
+		}
+	}
+
+	void insertSlot(std::size_t hash, entry_iterator entry) noexcept {
+		std::size_t idx = hash & mask();
+		while(slots_[idx].entry_ != entry_iterator{}) {
+			idx = (idx + 1) & mask();
+		}
+		slots_[idx] = Slot{entry, hash};
+	}
+
+	// Backward shift deletion: later slots of the probe run move into the hole
+	// unless that would place them before their home slot. No tombstones.
+	void eraseSlot(std::size_t hole) noexcept {
+		for(std::size_t idx = (hole + 1) & mask(); slots_[idx].entry_ != entry_iterator{}; idx = (idx + 1) & mask()) {
+			const std::size_t home = slots_[idx].hash_ & mask();
+			if(((idx - home) & mask()) >= ((idx - hole) & mask())) {
+				slots_[hole] = slots_[idx];
+				hole = idx;
+			}
+		}
+		slots_[hole] = Slot{};
+	}
+
+	void eraseEntry(std::size_t slot) noexcept {
+		entry_iterator entry = slots_[slot].entry_;
+		eraseSlot(slot);
+		weight_ -= entry->weight_;
+		entries_.erase(entry);
+	}
+
+	// Unlinks the least recently used entry and hands its node back for reuse.
+	node_type evictBack() noexcept {
+		entry_iterator last = --entries_.end();
+		eraseSlot(slotOf(last));
+		weight_ -= last->weight_;
+		++stats_.evictions_;
+		return entries_.extract(last);
+	}
+
+	void evictTo(std::size_t capacity) noexcept {
+		while(weight_ > capacity) {
+			evictBack();
+		}
+	}
+
+	entry_list entries_;
+	std::vector<Slot> slots_;
+	std::size_t capacity_;
+	std::size_t weight_ = 0;
+	cache_stats stats_;
+	[[no_unique_address]] Weigher weigher_;
+	[[no_unique_address]] Hash hash_;
+	[[no_unique_address]] KeyEqual equal_;
+};
+
+} // namespace exp
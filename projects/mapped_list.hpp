@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "iterator.hpp"
+
+// On-disk list of trivially copyable T that is used in place through mmap.
+// Layout, native byte order:
+//     mapped_list_header, padded to the node alignment
+//     mapped_node<T> records
+// Links are byte offsets from the start of the file, 0 means none (offset 0 is
+// the header). write_mapped_list stores the nodes in list order, so a warm
+// restart maps the file and walks it sequentially without building anything.
+
+namespace exp {
+
+struct mapped_list_header {
+	static constexpr std::uint64_t magic_value = 0x31545349'4c505845ULL; // "EXPLIST1" read little endian
+	static constexpr std::uint32_t current_version = 1;
+
+	std::uint64_t magic_;
+	std::uint32_t version_;
+	std::uint32_t node_size_;
+	std::uint32_t node_align_;
+	std::uint32_t value_size_;
+	std::uint64_t count_;
+	std::uint64_t head_;
+	std::uint64_t tail_;
+};
+
+template<typename T>
+struct mapped_node {
+	std::uint64_t next_;
+	std::uint64_t prev_;
+	T value_;
+};
+
+namespace details {
+
+template<typename T>
+constexpr std::size_t mapped_first_node() noexcept {
+	constexpr std::size_t align = alignof(mapped_node<T>);
+	return (sizeof(mapped_list_header) + align - 1) / align * align;
+}
+
+inline std::runtime_error mapped_error(const std::string& what, const std::filesystem::path& path) {
+	return std::runtime_error("mapped_list: " + what + " '" + path.string() + "'" + (errno ? std::string(": ") + std::strerror(errno) : std::string()));
+}
+
+// Flushes a file or, with O_DIRECTORY, a directory entry list to the device.
+inline void sync_path(const std::filesystem::path& path, int flags) {
+	errno = 0;
+	const int fd = ::open(path.c_str(), flags | O_CLOEXEC);
+	if(fd < 0) {
+		throw mapped_error("cannot open", path);
+	}
+	const int result = ::fsync(fd);
+	::close(fd);
+	if(result != 0) {
+		throw mapped_error("cannot sync", path);
+	}
+}
+
+} // namespace details
+
+// Read-only view of a file written by write_mapped_list. Opening checks the
+// header against T and the file size; the links themselves are trusted.
+template<typename T>
+class mapped_list {
+	static_assert(std::is_trivially_copyable_v<T>, "mapped_list needs a trivially copyable T");
+	using Node = mapped_node<T>;
+public:
+	using value_type = T;
+	using const_reference = const T&;
+	using size_type = std::size_t;
+
+	// ============= Iterator ============= //
+
+	class mapped_iterator: public iterator_facade<mapped_iterator, const T, std::bidirectional_iterator_tag> {
+	public:
+		mapped_iterator() noexcept = default;
+		mapped_iterator(const std::byte* base, std::uint64_t offset) noexcept: base_(base), offset_(offset) {}
+
+		const T& dereference() const noexcept { return node()->value_; }
+		void increment() noexcept { offset_ = node()->next_; }
+		// end() steps back to the tail.
+		void decrement() noexcept { offset_ = offset_ ? node()->prev_ : header()->tail_; }
+
+		bool equal(const mapped_iterator& rhs) const noexcept { return offset_ == rhs.offset_; }
+	private:
+		const Node* node() const noexcept { return reinterpret_cast<const Node*>(base_ + offset_); }
+		const mapped_list_header* header() const noexcept { return reinterpret_cast<const mapped_list_header*>(base_); }
+
+		const std::byte* base_ = nullptr;
+		std::uint64_t offset_{};
+	};
+
+	using iterator = mapped_iterator;
+	using const_iterator = mapped_iterator;
+
+	// ==================================== //
+
+	explicit mapped_list(const std::filesystem::path& path) {
+		errno = 0;
+		const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if(fd < 0) {
+			throw details::mapped_error("cannot open", path);
+		}
+		struct stat st{};
+		if(::fstat(fd, &st) != 0) {
+			::close(fd);
+			throw details::mapped_error("cannot stat", path);
+		}
+		bytes_ = static_cast<std::size_t>(st.st_size);
+		if(bytes_ < sizeof(mapped_list_header)) {
+			::close(fd);
+			errno = 0;
+			throw details::mapped_error("truncated header in", path);
+		}
+
+		void* mapping = ::mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if(mapping == MAP_FAILED) {
+			throw details::mapped_error("cannot map", path);
+		}
+		base_ = static_cast<const std::byte*>(mapping);
+		// Warm restarts walk the whole file front to back.
+		::madvise(mapping, bytes_, MADV_SEQUENTIAL);
+		::madvise(mapping, bytes_, MADV_WILLNEED);
+
+		try {
+			checkHeader(path);
+		} catch(...) {
+			::munmap(mapping, bytes_);
+			throw;
+		}
+	}
+
+	mapped_list(const mapped_list&) = delete;
+	mapped_list& operator=(const mapped_list&) = delete;
+
+	mapped_list(mapped_list&& other) noexcept:
+		base_(std::exchange(other.base_, nullptr)),
+		bytes_(std::exchange(other.bytes_, 0)) {}
+
+	mapped_list& operator=(mapped_list&& other) noexcept {
+		if(this != &other) {
+			unmap();
+			base_ = std::exchange(other.base_, nullptr);
+			bytes_ = std::exchange(other.bytes_, 0);
+		}
+		return *this;
+	}
+
+	~mapped_list() { unmap(); }
+
+	const_iterator begin() const noexcept { return const_iterator(base_, header().head_); }
+	const_iterator end() const noexcept { return const_iterator(base_, 0); }
+	const_iterator cbegin() const noexcept { return begin(); }
+	const_iterator cend() const noexcept { return end(); }
+
+	size_type size() const noexcept { return static_cast<size_type>(header().count_); }
+	bool empty() const noexcept { return header().count_ == 0; }
+
+	const T& front() const noexcept { return *begin(); }
+	const T& back() const noexcept { return *std::prev(end()); }
+
+private:
+	const mapped_list_header& header() const noexcept { return *reinterpret_cast<const mapped_list_header*>(base_); }
+
+	void checkHeader(const std::filesystem::path& path) const {
+		errno = 0;
+		const mapped_list_header& hdr = header();
+		if(hdr.magic_ != mapped_list_header::magic_value || hdr.version_ != mapped_list_header::current_version) {
+			throw details::mapped_error("not a mapped list file (or other byte order/version)", path);
+		}
+		if(hdr.node_size_ != sizeof(Node) || hdr.node_align_ != alignof(Node) || hdr.value_size_ != sizeof(T)) {
+			throw details::mapped_error("element layout does not match T in", path);
+		}
+		const std::uint64_t nodes_end = details::mapped_first_node<T>() + hdr.count_ * sizeof(Node);
+		if(hdr.count_ > bytes_ / sizeof(Node) || nodes_end > bytes_) {
+			throw details::mapped_error("truncated node records in", path);
+		}
+		const auto valid = [&](std::uint64_t offset) {
+			return offset >= details::mapped_first_node<T>() && offset < nodes_end && (offset - details::mapped_first_node<T>()) % sizeof(Node) == 0;
+		};
+		if(hdr.count_ == 0 ? (hdr.head_ != 0 || hdr.tail_ != 0) : (!valid(hdr.head_) || !valid(hdr.tail_))) {
+			throw details::mapped_error("corrupt head or tail link in", path);
+		}
+	}
+
+	void unmap() noexcept {
+		if(base_) {
+			::munmap(const_cast<std::byte*>(base_), bytes_);
+		}
+	}
+
+	const std::byte* base_ = nullptr;
+	std::size_t bytes_{};
+};
+
+// Streams range (e.g. an exp::list<T>) into path in the mapped_list format.
+// The file is written next to path, synced and renamed over it once complete,
+// and the directory is synced after the rename, so neither readers nor a warm
+// restart after a crash observe a half-written list. On failure the temporary
+// file is removed.
+template<typename Range>
+void write_mapped_list(const Range& range, const std::filesystem::path& path) {
+	using T = std::remove_cvref_t<decltype(*std::begin(range))>;
+	using Node = mapped_node<T>;
+	static_assert(std::is_trivially_copyable_v<T>, "write_mapped_list needs a trivially copyable T");
+	constexpr std::size_t first_node = details::mapped_first_node<T>();
+	constexpr std::size_t batch = 4096;
+
+	std::filesystem::path tmp_path = path;
+	tmp_path += ".tmp";
+	std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+	if(!out) {
+		throw details::mapped_error("cannot create", tmp_path);
+	}
+
+	try {
+		std::vector<std::byte> preamble(first_node);
+		out.write(reinterpret_cast<const char*>(preamble.data()), static_cast<std::streamsize>(preamble.size()));
+
+		// Zeroed raw records, so padding bytes in the file are deterministic. A batch is
+		// flushed only when the next element arrives, the tail's next link stays 0.
+		struct alignas(Node) NodeBytes {
+			std::byte bytes_[sizeof(Node)];
+		};
+		std::vector<NodeBytes> nodes;
+		nodes.reserve(batch);
+		const auto flush = [&]() {
+			out.write(reinterpret_cast<const char*>(nodes.data()), static_cast<std::streamsize>(nodes.size() * sizeof(Node)));
+			nodes.clear();
+		};
+
+		std::uint64_t count = 0;
+		for(const T& value : range) {
+			if(nodes.size() == batch) {
+				flush();
+			}
+			const std::uint64_t offset = first_node + count * sizeof(Node);
+			auto* node = reinterpret_cast<Node*>(nodes.emplace_back().bytes_);
+			node->next_ = offset + sizeof(Node);
+			node->prev_ = count == 0 ? 0 : offset - sizeof(Node);
+			std::memcpy(&node->value_, std::addressof(value), sizeof(T));
+			++count;
+		}
+		if(!nodes.empty()) {
+			reinterpret_cast<Node*>(nodes.back().bytes_)->next_ = 0;
+			flush();
+		}
+
+		mapped_list_header header{};
+		header.magic_ = mapped_list_header::magic_value;
+		header.version_ = mapped_list_header::current_version;
+		header.node_size_ = sizeof(Node);
+		header.node_align_ = alignof(Node);
+		header.value_size_ = sizeof(T);
+		header.count_ = count;
+		header.head_ = count ? first_node : 0;
+		header.tail_ = count ? first_node + (count - 1) * sizeof(Node) : 0;
+		out.seekp(0);
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		out.close();
+		if(!out) {
+			throw details::mapped_error("cannot write", tmp_path);
+		}
+		details::sync_path(tmp_path, O_WRONLY);
+		std::filesystem::rename(tmp_path, path);
+	} catch(...) {
+		out.close();
+		std::error_code ignored;
+		std::filesystem::remove(tmp_path, ignored);
+		throw;
+	}
+	std::filesystem::path dir = path.parent_path();
+	details::sync_path(dir.empty() ? std::filesystem::path(".") : dir, O_RDONLY | O_DIRECTORY);
+}
+
+} // namespace exp
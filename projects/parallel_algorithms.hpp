@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "iterator.hpp"
+#include "parallel_reduce.hpp"
+#include "work_stealing_pool.hpp"
+
+// STL-style algorithms running on a work_stealing_pool, taking ranges such as
+// exp::list, std::vector or zip_range directly. Random-access ranges (vectors,
+// zips of contiguous columns) are split by index. Other ranges are walked once
+// to cut them into segments, using size() when the range has one instead of a
+// counting pass. Segments are processed in any order, results are combined in
+// range order, so reduce only needs an associative operation.
+
+namespace exp::parallel {
+
+namespace details {
+
+// Ranges smaller than this many elements per segment are not worth a task.
+inline constexpr std::size_t min_segment_size = 2048;
+
+template<typename R>
+using iterator_t = decltype(std::begin(std::declval<R&>()));
+
+template<typename R>
+std::size_t range_size(R& range) {
+    if constexpr (requires { std::size(range); }) {
+        return static_cast<std::size_t>(std::size(range));
+    } else {
+        return static_cast<std::size_t>(std::distance(std::begin(range), std::end(range)));
+    }
+}
+
+// Boundaries of about 8 segments per worker, bounds[i], bounds[i + 1] is segment i.
+template<typename R>
+std::vector<iterator_t<R>> segments(work_stealing_pool& pool, R& range) {
+    using It = iterator_t<R>;
+    const std::size_t n = range_size(range);
+    const std::size_t chunk = std::max(min_segment_size, n / (pool.size() * 8));
+
+    std::vector<It> bounds;
+    bounds.reserve(n / chunk + 2);
+    It first = std::begin(range);
+    const It last = std::end(range);
+    if constexpr (std::random_access_iterator<It>) {
+        for(std::size_t idx = 0; idx < n; idx += chunk) {
+            bounds.push_back(first + static_cast<std::ptrdiff_t>(idx));
+        }
+    } else {
+        for(std::size_t idx = 0; first != last; ++idx, ++first) {
+            if(idx % chunk == 0) {
+                bounds.push_back(first);
+            }
+        }
+    }
+    bounds.push_back(last);
+    return bounds;
+}
+
+// Calls job(segment, first, last) for every segment.
+template<typename It, typename Job>
+void run_segments(work_stealing_pool& pool, const std::vector<It>& bounds, Job job) {
+    const std::size_t count = bounds.size() - 1;
+    if(count == 1) {
+        job(std::size_t{0}, bounds[0], bounds[1]);
+    } else if(count > 1) {
+        pool.parallel_for(std::size_t{0}, count, [&](std::size_t segment) {
+            job(segment, bounds[segment], bounds[segment + 1]);
+        }, std::size_t{1});
+    }
+}
+
+} // namespace details
+
+template<typename R, typename F>
+void for_each(work_stealing_pool& pool, R&& range, F func) {
+    details::run_segments(pool, details::segments(pool, range), [&](std::size_t, auto first, auto last) {
+        for(; first != last; ++first) {
+            std::invoke(func, *first);
+        }
+    });
+}
+
+// Writes func(x) for every x of in to the element of out at the same position.
+// out must have the size of in, e.g. a second list or vector.
+template<typename In, typename Out, typename F>
+void transform(work_stealing_pool& pool, In&& in, Out&& out, F func) {
+    for_each(pool, zip_range<In&, Out&>(in, out), [&](auto&& row) {
+        std::get<1>(row) = std::invoke(func, std::get<0>(row));
+    });
+}
+
+template<typename R, typename T, typename Reduce = std::plus<>>
+T reduce(work_stealing_pool& pool, R&& range, T init, Reduce op = {}) {
+    const auto bounds = details::segments(pool, range);
+    std::vector<exp::details::padded<T>> partials(bounds.size() - 1, exp::details::padded<T>{init});
+
+    details::run_segments(pool, bounds, [&](std::size_t segment, auto first, auto last) {
+        T acc = *first;
+        for(++first; first != last; ++first) {
+            acc = std::invoke(op, std::move(acc), *first);
+        }
+        partials[segment].value_ = std::move(acc);
+    });
+
+    for(auto& partial : partials) {
+        init = std::invoke(op, std::move(init), std::move(partial.value_));
+    }
+    return init;
+}
+
+template<typename R, typename Pred>
+std::size_t count_if(work_stealing_pool& pool, R&& range, Pred pred) {
+    const auto bounds = details::segments(pool, range);
+    std::vector<exp::details::padded<std::size_t>> counts(bounds.size() - 1, exp::details::padded<std::size_t>{0});
+
+    details::run_segments(pool, bounds, [&](std::size_t segment, auto first, auto last) {
+        std::size_t count = 0;
+        for(; first != last; ++first) {
+            count += std::invoke(pred, *first) ? 1 : 0;
+        }
+        counts[segment].value_ = count;
+    });
+
+    std::size_t total = 0;
+    for(const auto& count : counts) {
+        total += count.value_;
+    }
+    return total;
+}
+
+// First element satisfying pred, in range order. Segments after the earliest
+// match found so far are skipped or stop early. The result points into range,
+// so temporaries are only accepted when their iterators don't dangle.
+template<typename R, typename Pred>
+requires std::is_lvalue_reference_v<R> || std::ranges::borrowed_range<R>
+details::iterator_t<R> find_if(work_stealing_pool& pool, R&& range, Pred pred) {
+    const auto bounds = details::segments(pool, range);
+    std::vector<details::iterator_t<R>> found(bounds.size() - 1, bounds.back());
+    std::atomic<std::size_t> best{std::numeric_limits<std::size_t>::max()};
+
+    details::run_segments(pool, bounds, [&](std::size_t segment, auto first, auto last) {
+        for(; first != last; ++first) {
+            if(segment > best.load(std::memory_order_relaxed)) {
+                return;
+            }
+            if(std::invoke(pred, *first)) {
+                found[segment] = first;
+                std::size_t curr = best.load(std::memory_order_relaxed);
+                while(segment < curr && !best.compare_exchange_weak(curr, segment, std::memory_order_relaxed)) {}
+                return;
+            }
+        }
+    });
+
+    const std::size_t segment = best.load(std::memory_order_relaxed);
+    return segment < found.size() ? found[segment] : bounds.back();
+}
+
+} // namespace exp::parallel
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <algorithm>
+#include <cstdint>
+#include "prng.hpp"
+
+namespace exp {
+
+// Fork-join pool running one job at a time. A job is a number of chunks that the
+// workers and the calling thread claim from a shared counter until none are left.
+class chunked_thread_pool {
+public:
+    explicit chunked_thread_pool(std::size_t threads = std::thread::hardware_concurrency()) {
+        const std::size_t workers = threads > 1 ? threads - 1 : 0;
+        workers_.reserve(workers);
+        for(std::size_t i = 0; i < workers; ++i) {
+            workers_.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    chunked_thread_pool(const chunked_thread_pool&) = delete;
+    chunked_thread_pool& operator=(const chunked_thread_pool&) = delete;
+
+    ~chunked_thread_pool() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        start_cv_.notify_all();
+        for(auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    // Number of threads taking part in a job, the caller included.
+    std::size_t size() const noexcept { return workers_.size() + 1; }
+
+    // Calls job(chunk) for every chunk in [0, chunks) and blocks until all are done.
+    // The first exception thrown by a chunk is rethrown here.
+    template<typename F>
+    void run(std::size_t chunks, F&& job) {
+        Job current;
+        current.chunks_ = chunks;
+        current.context_ = std::addressof(job);
+        current.invoke_ = [](void* ctx, std::size_t chunk) { (*static_cast<std::remove_reference_t<F>*>(ctx))(chunk); };
+        current.active_workers_ = workers_.size();
+
+        {
+            std::lock_guard lock(mutex_);
+            job_ = &current;
+            ++generation_;
+        }
+        start_cv_.notify_all();
+
+        processChunks(current);
+
+        std::unique_lock lock(mutex_);
+        done_cv_.wait(lock, [&current]() { return current.active_workers_ == 0; });
+        job_ = nullptr;
+        lock.unlock();
+
+        if(current.error_) {
+            std::rethrow_exception(current.error_);
+        }
+    }
+
+private:
+    struct Job {
+        std::size_t chunks_{};
+        void* context_ = nullptr;
+        void (*invoke_)(void*, std::size_t) = nullptr;
+        std::atomic<std::size_t> next_chunk_{0};
+        std::size_t active_workers_{};
+        std::exception_ptr error_;
+        std::once_flag error_flag_;
+    };
+
+    void workerLoop() {
+        std::uint64_t seen = 0;
+        for(;;) {
+            Job* job = nullptr;
+            {
+                std::unique_lock lock(mutex_);
+                start_cv_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+                if(stop_) {
+                    return;
+                }
+                seen = generation_;
+                job = job_;
+            }
+
+            processChunks(*job);
+
+            std::lock_guard lock(mutex_);
+            if(--job->active_workers_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+
+    static void processChunks(Job& job) noexcept {
+        for(;;) {
+            const std::size_t chunk = job.next_chunk_.fetch_add(1, std::memory_order_relaxed);
+            if(chunk >= job.chunks_) {
+                return;
+            }
+            try {
+                job.invoke_(job.context_, chunk);
+            } catch(...) {
+                std::call_once(job.error_flag_, [&job]() { job.error_ = std::current_exception(); });
+                job.next_chunk_.store(job.chunks_, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    Job* job_ = nullptr;
+    std::uint64_t generation_{};
+    bool stop_ = false;
+};
+
+namespace details {
+
+// Elements per chunk, kept independent of the thread count so results (and the
+// random streams of parallel_generate) don't change with the pool size.
+inline constexpr std::size_t reduce_chunk_size = 1 << 16;
+
+template<typename T>
+struct alignas(64) padded {
+    T value_;
+};
+
+// Eight independent accumulators break the dependency chain on reduce, which
+// lets the compiler keep them in vector registers.
+template<typename It, typename T, typename Reduce, typename Transform>
+T transform_reduce_block(It first, std::size_t n, T init, Reduce& reduce, Transform& transform) {
+    constexpr std::size_t lanes = 8;
+    std::size_t idx = 0;
+    if(n >= lanes) {
+        T acc[lanes];
+        for(std::size_t lane = 0; lane < lanes; ++lane) {
+            acc[lane] = transform(first[lane]);
+        }
+        for(idx = lanes; idx + lanes <= n; idx += lanes) {
+            for(std::size_t lane = 0; lane < lanes; ++lane) {
+                acc[lane] = reduce(acc[lane], transform(first[idx + lane]));
+            }
+        }
+        for(std::size_t lane = 0; lane < lanes; ++lane) {
+            init = reduce(init, acc[lane]);
+        }
+    }
+    for(; idx < n; ++idx) {
+        init = reduce(init, transform(first[idx]));
+    }
+    return init;
+}
+
+} // namespace details
+
+template<std::random_access_iterator It, typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(chunked_thread_pool& pool, It first, It last, T init, Reduce reduce, Transform transform) {
+    const auto n = static_cast<std::size_t>(last - first);
+    const std::size_t chunks = (n + details::reduce_chunk_size - 1) / details::reduce_chunk_size;
+    if(chunks <= 1) {
+        return details::transform_reduce_block(first, n, init, reduce, transform);
+    }
+
+    std::vector<details::padded<T>> partials(chunks, details::padded<T>{init});
+    pool.run(chunks, [&](std::size_t chunk) {
+        const std::size_t begin = chunk * details::reduce_chunk_size;
+        const std::size_t count = std::min(details::reduce_chunk_size, n - begin);
+        auto acc = transform(first[begin]);
+        partials[chunk].value_ = details::transform_reduce_block(first + begin + 1, count - 1, T(acc), reduce, transform);
+    });
+
+    for(const auto& partial : partials) {
+        init = reduce(init, partial.value_);
+    }
+    return init;
+}
+
+template<std::random_access_iterator It, typename T, typename Reduce = std::plus<>>
+T parallel_reduce(chunked_thread_pool& pool, It first, It last, T init, Reduce reduce = {}) {
+    return parallel_transform_reduce(pool, first, last, init, reduce, [](const auto& val) -> T { return val; });
+}
+
+// Fills [first, last) with gen(engine) where every chunk gets its own engine
+// seeded from (seed, chunk index). The output only depends on seed.
+template<std::random_access_iterator It, typename Gen, typename Engine = xoshiro256>
+void parallel_generate(chunked_thread_pool& pool, It first, It last, std::uint64_t seed, Gen gen) {
+    const auto n = static_cast<std::size_t>(last - first);
+    const std::size_t chunks = (n + details::reduce_chunk_size - 1) / details::reduce_chunk_size;
+
+    pool.run(chunks, [&](std::size_t chunk) {
+        Engine engine(splitmix64(seed ^ (chunk * 0x9e3779b97f4a7c15ULL))());
+        const std::size_t begin = chunk * details::reduce_chunk_size;
+        const std::size_t end = std::min(n, begin + details::reduce_chunk_size);
+        for(std::size_t idx = begin; idx < end; ++idx) {
+            first[idx] = gen(engine);
+        }
+    });
+}
+
+} // namespace exp
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+#include <type_traits>
+
+namespace exp {
+
+// Fixed-size block pool. Blocks are carved from contiguous slabs with a bump
+// pointer, so consecutive allocations are adjacent in memory; freed blocks go to
+// an intrusive free list and are handed out again before the slab grows.
+// Not thread safe: one pool is meant to serve one container.
+class node_pool {
+public:
+	static constexpr std::size_t min_blocks_per_slab = 32;
+	static constexpr std::size_t max_blocks_per_slab = 1 << 16;
+
+	node_pool(std::size_t block_size, std::size_t block_align) noexcept:
+		align_(block_align < alignof(FreeBlock) ? alignof(FreeBlock) : block_align),
+		block_size_(roundUp(block_size < sizeof(FreeBlock) ? sizeof(FreeBlock) : block_size, align_)) {}
+
+	node_pool(const node_pool&) = delete;
+	node_pool& operator=(const node_pool&) = delete;
+
+	~node_pool() {
+		while(slabs_) {
+			Slab* next = slabs_->next_;
+			::operator delete(static_cast<void*>(slabs_), std::align_val_t{align_});
+			slabs_ = next;
+		}
+	}
+
+	void* allocate() {
+		if(free_list_) {
+			FreeBlock* block = free_list_;
+			free_list_ = block->next_;
+			return block;
+		}
+		if(cursor_ == slab_end_) {
+			addSlab();
+		}
+		void* block = cursor_;
+		cursor_ += block_size_;
+		return block;
+	}
+
+	// n adjacent blocks, each of them is released on its own with deallocate().
+	// The free list is bypassed since its blocks are scattered; what is left of a
+	// slab too small for the request goes to the free list instead.
+	void* allocate_bulk(std::size_t n) {
+		const std::size_t bytes = n * block_size_;
+		if(static_cast<std::size_t>(slab_end_ - cursor_) < bytes) {
+			while(cursor_ != slab_end_) {
+				deallocate(cursor_);
+				cursor_ += block_size_;
+			}
+			addSlab(n);
+		}
+		void* blocks = cursor_;
+		cursor_ += bytes;
+		return blocks;
+	}
+
+	void deallocate(void* block) noexcept {
+		auto* free_block = static_cast<FreeBlock*>(block);
+		free_block->next_ = free_list_;
+		free_list_ = free_block;
+	}
+
+	std::size_t block_size() const noexcept { return block_size_; }
+	std::size_t block_align() const noexcept { return align_; }
+	std::size_t slab_count() const noexcept { return slab_count_; }
+
+private:
+	struct FreeBlock {
+		FreeBlock* next_;
+	};
+
+	struct Slab {
+		Slab* next_;
+	};
+
+	static constexpr std::size_t roundUp(std::size_t value, std::size_t align) noexcept {
+		return (value + align - 1) / align * align;
+	}
+
+	void addSlab(std::size_t min_blocks = 0) {
+		const std::size_t header = roundUp(sizeof(Slab), align_);
+		const std::size_t bytes = header + (min_blocks > next_slab_blocks_ ? min_blocks : next_slab_blocks_) * block_size_;
+
+		auto* slab = static_cast<Slab*>(::operator new(bytes, std::align_val_t{align_}));
+		slab->next_ = slabs_;
+		slabs_ = slab;
+		++slab_count_;
+
+		cursor_ = reinterpret_cast<std::byte*>(slab) + header;
+		slab_end_ = reinterpret_cast<std::byte*>(slab) + bytes;
+
+		if(next_slab_blocks_ < max_blocks_per_slab) {
+			next_slab_blocks_ *= 2;
+		}
+	}
+
+	std::size_t align_;
+	std::size_t block_size_;
+	std::size_t next_slab_blocks_ = min_blocks_per_slab;
+	std::size_t slab_count_{};
+
+	FreeBlock* free_list_ = nullptr;
+	Slab* slabs_ = nullptr;
+	std::byte* cursor_ = nullptr;
+	std::byte* slab_end_ = nullptr;
+};
+
+// Set of pools keyed by block geometry. Shared between all copies and rebinds
+// of one pool_allocator so that rebinding to a container's node type keeps the
+// allocator equality guarantees.
+class node_pool_set {
+public:
+	node_pool& poolFor(std::size_t block_size, std::size_t block_align) {
+		for(auto& pool : pools_) {
+			if(pool->block_size() == block_size && pool->block_align() == block_align) {
+				return *pool;
+			}
+		}
+		return *pools_.emplace_back(std::make_unique<node_pool>(block_size, block_align));
+	}
+private:
+	std::vector<std::unique_ptr<node_pool>> pools_;
+};
+
+// Allocator serving single-object requests from a node_pool. Requests for more
+// than one object fall through to the global heap.
+template<typename T>
+class pool_allocator {
+	template<typename U>
+	friend class pool_allocator;
+public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::false_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+	using is_always_equal = std::false_type;
+
+	template<typename U>
+	struct rebind {
+		using other = pool_allocator<U>;
+	};
+
+	pool_allocator(): pool_set_(std::make_shared<node_pool_set>()), pool_(&pool_set_->poolFor(sizeof(T), alignof(T))) {}
+
+	pool_allocator(const pool_allocator& other) noexcept = default;
+	pool_allocator& operator=(const pool_allocator& other) noexcept = default;
+
+	template<typename U>
+	pool_allocator(const pool_allocator<U>& other): pool_set_(other.pool_set_), pool_(&pool_set_->poolFor(sizeof(T), alignof(T))) {}
+
+	T* allocate(std::size_t n) {
+		if(n == 1) {
+			return static_cast<T*>(pool_->allocate());
+		}
+		return std::allocator<T>{}.allocate(n);
+	}
+
+	// n adjacent objects carved from one slab, each released with deallocate(ptr, 1).
+	// Only offered when the pool block stride equals sizeof(T).
+	T* allocate_bulk(std::size_t n) requires (sizeof(T) >= sizeof(void*) && sizeof(T) % alignof(void*) == 0) {
+		return static_cast<T*>(pool_->allocate_bulk(n));
+	}
+
+	void deallocate(T* ptr, std::size_t n) noexcept {
+		if(n == 1) {
+			pool_->deallocate(ptr);
+			return;
+		}
+		std::allocator<T>{}.deallocate(ptr, n);
+	}
+
+	// Copies of a container get their own pool instead of sharing the source's one.
+	pool_allocator select_on_container_copy_construction() const { return pool_allocator(); }
+
+	node_pool& pool() const noexcept { return *pool_; }
+
+	friend bool operator==(const pool_allocator& lhs, const pool_allocator& rhs) noexcept {
+		return lhs.pool_set_ == rhs.pool_set_;
+	}
+
+private:
+	std::shared_ptr<node_pool_set> pool_set_;
+	node_pool* pool_;
+};
+
+} // namespace exp
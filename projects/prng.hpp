@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <cstdint>
+#include <limits>
+
+// <random> can't be used next to namespace exp (its <cmath> declares ::exp),
+// so the library carries its own small generators.
+
+namespace exp {
+
+// Finalizer of splitmix64, every input bit affects every output bit. Also used
+// to spread weak hashes such as the identity std::hash of integers.
+constexpr std::uint64_t mix64(std::uint64_t z) noexcept {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// splitmix64, used to expand one seed into independent generator states.
+class splitmix64 {
+public:
+    using result_type = std::uint64_t;
+
+    explicit constexpr splitmix64(std::uint64_t seed) noexcept: state_(seed) {}
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr result_type operator()() noexcept {
+        return mix64(state_ += 0x9e3779b97f4a7c15ULL);
+    }
+private:
+    std::uint64_t state_;
+};
+
+// xoshiro256**, satisfies std::uniform_random_bit_generator.
+class xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    explicit constexpr xoshiro256(std::uint64_t seed) noexcept {
+        splitmix64 seeder(seed);
+        for(auto& word : state_) {
+            word = seeder();
+        }
+    }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr result_type operator()() noexcept {
+        const std::uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const std::uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+private:
+    static constexpr std::uint64_t rotl(std::uint64_t x, int k) noexcept { return (x << k) | (x >> (64 - k)); }
+
+    std::uint64_t state_[4]{};
+};
+
+// Uniform integer in [lo, hi] with Lemire's multiply-shift reduction.
+template<typename Int, typename Engine>
+constexpr Int uniform_int(Engine& engine, Int lo, Int hi) noexcept {
+    const auto range = static_cast<std::uint64_t>(hi) - static_cast<std::uint64_t>(lo) + 1;
+    if(range == 0) {
+        return static_cast<Int>(engine());
+    }
+    const auto product = static_cast<unsigned __int128>(engine()) * range;
+    return static_cast<Int>(static_cast<std::uint64_t>(lo) + static_cast<std::uint64_t>(product >> 64));
+}
+
+} // namespace exp
@@ -0,0 +1,410 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "iterator.hpp"
+#include "allocation_stats.hpp"
+
+namespace exp {
+
+// Double-ended queue over one circular buffer whose capacity is a power of two,
+// so a logical index maps to a slot with a mask instead of a division. Pushing
+// and popping at either end is O(1) and allocates only when the buffer doubles;
+// a FIFO in steady state never touches the allocator, unlike exp::list which
+// pays one allocation and one free per element.
+// The live elements form at most two contiguous spans, which is what the bulk
+// push_back_n/pop_front_n copy through. Growing relocates the elements: it
+// invalidates references and iterators like std::vector.
+template<typename T, typename Allocator = default_allocator<T>>
+class ring_deque {
+public:
+	static constexpr std::size_t min_capacity = 16;
+
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	// ============= Iterator ============= //
+
+	template<bool isConst>
+	class ring_iterator: public iterator_facade<ring_iterator<isConst>, std::conditional_t<isConst, const T, T>, std::random_access_iterator_tag> {
+		using BaseType = iterator_facade<ring_iterator<isConst>, std::conditional_t<isConst, const T, T>, std::random_access_iterator_tag>;
+		friend ring_deque;
+	public:
+		using value_type = typename BaseType::value_type;
+		using reference = typename BaseType::reference;
+		using iterator_category = typename BaseType::iterator_category;
+		using difference_type = typename BaseType::difference_type;
+
+		using owner_pointer = std::conditional_t<isConst, const ring_deque*, ring_deque*>;
+
+		ring_iterator() noexcept = default;
+		ring_iterator(owner_pointer owner, std::size_t index) noexcept: owner_(owner), index_(index) {}
+
+		template<bool wasConst> requires (isConst && !wasConst)
+		ring_iterator(const ring_iterator<wasConst>& other) noexcept: owner_(other.owner_), index_(other.index_) {}
+
+		reference dereference() const noexcept { return (*owner_)[index_]; }
+		void increment() noexcept { ++index_; }
+		void decrement() noexcept { --index_; }
+		void advance(difference_type n) noexcept { index_ += static_cast<std::size_t>(n); }
+		difference_type distance_to(const ring_iterator& other) const noexcept {
+			return static_cast<difference_type>(other.index_ - index_);
+		}
+
+		bool equal(const ring_iterator& rhs) const noexcept { return index_ == rhs.index_; }
+	private:
+		template<bool> friend class ring_iterator;
+
+		owner_pointer owner_ = nullptr;
+		// Logical position, 0 is the front.
+		std::size_t index_{};
+	};
+
+	// ==================================== //
+
+	using iterator = ring_iterator<false>;
+	using const_iterator = ring_iterator<true>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	iterator begin() noexcept { return iterator(this, 0); }
+	const_iterator begin() const noexcept { return cbegin(); }
+	const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+	iterator end() noexcept { return iterator(this, size_); }
+	const_iterator end() const noexcept { return cend(); }
+	const_iterator cend() const noexcept { return const_iterator(this, size_); }
+
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+	ring_deque(): ring_deque(Allocator()) {}
+
+	explicit ring_deque(const Allocator& alloc): alloc_(alloc) {}
+
+	ring_deque(std::initializer_list<T> init_list): ring_deque() {
+		append(init_list.begin(), init_list.end());
+	}
+
+	template<std::input_iterator It>
+	ring_deque(It first, It last): ring_deque() {
+		append(first, last);
+	}
+
+	// The copy starts at slot 0, whatever the head of the source.
+	ring_deque(const ring_deque& other): ring_deque(Allocator(alloc_traits::select_on_container_copy_construction(other.alloc_))) {
+		append(other.begin(), other.end());
+	}
+
+	ring_deque(ring_deque&& other) noexcept:
+		buffer_(std::exchange(other.buffer_, nullptr)),
+		capacity_(std::exchange(other.capacity_, 0)),
+		head_(std::exchange(other.head_, 0)),
+		size_(std::exchange(other.size_, 0)),
+		alloc_(other.alloc_) {}
+
+	ring_deque& operator=(ring_deque other) noexcept {
+		swap(other);
+		return *this;
+	}
+
+	~ring_deque() {
+		clear();
+		if(buffer_) {
+			alloc_traits::deallocate(alloc_, buffer_, capacity_);
+		}
+	}
+
+	void swap(ring_deque& other) noexcept {
+		using std::swap;
+		swap(buffer_, other.buffer_);
+		swap(capacity_, other.capacity_);
+		swap(head_, other.head_);
+		swap(size_, other.size_);
+		swap(alloc_, other.alloc_);
+	}
+
+	friend void swap(ring_deque& lhs, ring_deque& rhs) noexcept { lhs.swap(rhs); }
+
+	size_type size() const noexcept { return size_; }
+	bool empty() const noexcept { return size_ == 0; }
+	size_type capacity() const noexcept { return capacity_; }
+
+	// Rounded up to a power of two.
+	void reserve(size_type count) {
+		if(count > capacity_) {
+			relocate(std::bit_ceil(std::max(count, min_capacity)));
+		}
+	}
+
+	allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+	T& operator[](size_type idx) noexcept { return buffer_[slot(idx)]; }
+	const T& operator[](size_type idx) const noexcept { return buffer_[slot(idx)]; }
+
+	T& front() noexcept { return buffer_[head_]; }
+	const T& front() const noexcept { return buffer_[head_]; }
+	T& back() noexcept { return (*this)[size_ - 1]; }
+	const T& back() const noexcept { return (*this)[size_ - 1]; }
+
+	// ============= Ends ============= //
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args) {
+		if(size_ == capacity_) {
+			return growAndEmplace(false, std::forward<Args>(args)...);
+		}
+		T* elem = std::construct_at(buffer_ + slot(size_), std::forward<Args>(args)...);
+		++size_;
+		return *elem;
+	}
+
+	template<typename... Args>
+	T& emplace_front(Args&&... args) {
+		if(size_ == capacity_) {
+			return growAndEmplace(true, std::forward<Args>(args)...);
+		}
+		const std::size_t head = (head_ - 1) & (capacity_ - 1);
+		T* elem = std::construct_at(buffer_ + head, std::forward<Args>(args)...);
+		head_ = head;
+		++size_;
+		return *elem;
+	}
+
+	void push_back(const T& val) { emplace_back(val); }
+	void push_back(T&& val) { emplace_back(std::move(val)); }
+
+	void push_front(const T& val) { emplace_front(val); }
+	void push_front(T&& val) { emplace_front(std::move(val)); }
+
+	void pop_back() noexcept {
+		std::destroy_at(buffer_ + slot(size_ - 1));
+		--size_;
+	}
+
+	void pop_front() noexcept {
+		std::destroy_at(buffer_ + head_);
+		head_ = (head_ + 1) & (capacity_ - 1);
+		--size_;
+	}
+
+	template<std::input_iterator It>
+	void append(It first, It last) {
+		if constexpr (std::forward_iterator<It>) {
+			reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+		}
+		for(; first != last; ++first) {
+			emplace_back(*first);
+		}
+	}
+
+	// Destroys every element, the buffer is kept for reuse.
+	void clear() noexcept {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			forEachSpan(0, size_, [](T* first, std::size_t count) { std::destroy_n(first, count); });
+		}
+		head_ = 0;
+		size_ = 0;
+	}
+
+	// ============= Bulk ============= //
+	// The free or the live region wraps at most once, so every bulk call is two
+	// span copies at most: memcpy for a trivially copyable T.
+
+	// Appends a copy of values, growing at most once. values must not refer to
+	// this deque.
+	void push_back_n(std::span<const T> values) {
+		reserve(size_ + values.size());
+		std::size_t done = 0;
+		try {
+			forEachSpan(size_, values.size(), [&values, &done](T* first, std::size_t count) {
+				copyTo(values.data() + done, count, first);
+				done += count;
+			});
+		} catch(...) {
+			forEachSpan(size_, done, [](T* first, std::size_t count) { std::destroy_n(first, count); });
+			throw;
+		}
+		size_ += values.size();
+	}
+
+	// Moves up to out.size() elements from the front into out, returns how many.
+	// Each span is dropped as soon as it is destroyed, so a move assignment that
+	// throws in the second span leaves the first one popped.
+	std::size_t pop_front_n(std::span<T> out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+		const std::size_t count = std::min(out.size(), size_);
+		std::size_t done = 0;
+		forEachSpan(0, count, [this, &out, &done](T* first, std::size_t span_count) {
+			if constexpr (std::is_trivially_copyable_v<T>) {
+				std::memcpy(static_cast<void*>(out.data() + done), first, span_count * sizeof(T));
+			} else {
+				std::move(first, first + span_count, out.data() + done);
+				std::destroy_n(first, span_count);
+			}
+			dropFront(span_count);
+			done += span_count;
+		});
+		return count;
+	}
+
+	// Destroys up to count elements from the front, returns how many.
+	std::size_t pop_front_n(std::size_t count) noexcept {
+		count = std::min(count, size_);
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			forEachSpan(0, count, [](T* first, std::size_t span_count) { std::destroy_n(first, span_count); });
+		}
+		dropFront(count);
+		return count;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const ring_deque& deque) {
+		for(const auto& el : deque) {
+			os << el << ' ';
+		}
+		return os;
+	}
+
+	friend bool operator==(const ring_deque& rhs, const ring_deque& lhs) noexcept {
+		return rhs.size() == lhs.size() && std::equal(rhs.begin(), rhs.end(), lhs.begin());
+	}
+	friend bool operator!=(const ring_deque& rhs, const ring_deque& lhs) noexcept {
+		return !(rhs == lhs);
+	}
+
+private:
+	using alloc_traits = std::allocator_traits<Allocator>;
+
+	std::size_t slot(std::size_t idx) const noexcept { return (head_ + idx) & (capacity_ - 1); }
+
+	// Calls func(first, count) for the one or two contiguous runs of slots that
+	// hold logical positions [pos, pos + count).
+	template<typename F>
+	void forEachSpan(std::size_t pos, std::size_t count, F&& func) const {
+		if(count == 0) {
+			return;
+		}
+		const std::size_t first = slot(pos);
+		const std::size_t head_run = std::min(count, capacity_ - first);
+		func(buffer_ + first, head_run);
+		if(head_run < count) {
+			func(buffer_, count - head_run);
+		}
+	}
+
+	static void copyTo(const T* from, std::size_t count, T* to) {
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			std::memcpy(static_cast<void*>(to), from, count * sizeof(T));
+		} else {
+			std::uninitialized_copy_n(from, count, to);
+		}
+	}
+
+	void dropFront(std::size_t count) noexcept {
+		size_ -= count;
+		head_ = size_ == 0 ? 0 : (head_ + count) & (capacity_ - 1);
+	}
+
+	// Moves the elements, front first, to the start of the block fresh.
+	void moveTo(T* fresh) {
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			forEachSpan(0, size_, [&fresh](T* first, std::size_t count) {
+				std::memcpy(static_cast<void*>(fresh), first, count * sizeof(T));
+				fresh += count;
+			});
+		} else {
+			std::size_t done = 0;
+			try {
+				forEachSpan(0, size_, [&fresh, &done](T* first, std::size_t count) {
+					if constexpr (std::is_nothrow_move_constructible_v<T>) {
+						std::uninitialized_move_n(first, count, fresh + done);
+					} else {
+						std::uninitialized_copy_n(first, count, fresh + done);
+					}
+					done += count;
+				});
+			} catch(...) {
+				std::destroy_n(fresh, done);
+				throw;
+			}
+			forEachSpan(0, size_, [](T* first, std::size_t count) { std::destroy_n(first, count); });
+		}
+	}
+
+	void adopt(T* fresh, std::size_t capacity, std::size_t head) noexcept {
+		if(buffer_) {
+			alloc_traits::deallocate(alloc_, buffer_, capacity_);
+		}
+		buffer_ = fresh;
+		capacity_ = capacity;
+		head_ = head;
+	}
+
+	void relocate(std::size_t capacity) {
+		T* fresh = alloc_traits::allocate(alloc_, capacity);
+		try {
+			moveTo(fresh);
+		} catch(...) {
+			alloc_traits::deallocate(alloc_, fresh, capacity);
+			throw;
+		}
+		adopt(fresh, capacity, 0);
+	}
+
+	// Doubles the buffer. The new element is built in the new block before the
+	// old ones move, since args may refer to one of them.
+	template<typename... Args>
+	T& growAndEmplace(bool front, Args&&... args) {
+		const std::size_t capacity = std::max(min_capacity, capacity_ * 2);
+		T* fresh = alloc_traits::allocate(alloc_, capacity);
+		T* elem = fresh + (front ? capacity - 1 : size_);
+		try {
+			std::construct_at(elem, std::forward<Args>(args)...);
+		} catch(...) {
+			alloc_traits::deallocate(alloc_, fresh, capacity);
+			throw;
+		}
+		try {
+			moveTo(fresh);
+		} catch(...) {
+			std::destroy_at(elem);
+			alloc_traits::deallocate(alloc_, fresh, capacity);
+			throw;
+		}
+		adopt(fresh, capacity, front ? capacity - 1 : 0);
+		++size_;
+		return *elem;
+	}
+
+	T* buffer_ = nullptr;
+	std::size_t capacity_{};
+	// Slot of the front element.
+	std::size_t head_{};
+	size_type size_{};
+	[[no_unique_address]] Allocator alloc_;
+};
+
+template<typename T>
+ring_deque(std::initializer_list<T>) -> ring_deque<T>;
+
+template<std::input_iterator It>
+ring_deque(It, It) -> ring_deque<typename std::iterator_traits<It>::value_type>;
+
+} // namespace exp
@@ -0,0 +1,6 @@
+BUILD_DIR=release
+if [ -d $BUILD_DIR ]; then
+  $BUILD_DIR/bench --benchmark_out=$BUILD_DIR/bench.json --benchmark_out_format=json $@
+else
+  echo "Directory build doesn't exists."
+fi
\ No newline at end of file
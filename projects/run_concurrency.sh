@@ -1,6 +1,6 @@
 BUILD_DIR=debug
 if [ -d $BUILD_DIR ]; then
-  $BUILD_DIR/concurrency $1
+  $BUILD_DIR/concurrency $@
 else
   echo "Directory build doesn't exists."
 fi
\ No newline at end of file
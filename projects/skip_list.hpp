@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "iterator.hpp"
+#include "list_hook.hpp"
+#include "pool_allocator.hpp"
+#include "prng.hpp"
+
+namespace exp {
+
+// Ordered multimap as a skip list. Level 0 is a circular doubly linked list of
+// list_hook nodes, so in-order scans walk plain list links. A node of height h
+// carries h - 1 forward pointers stored right after it in the same block; blocks
+// of every height come from their own node_pool. A node reaches level l + 1 with
+// probability 1/4, about 1.33 links per node. Equal keys keep insertion order, as
+// for time-ordered events sharing a timestamp. Inserting at or past the largest
+// key links against the per-level tails without a search.
+template<typename Key, typename T, typename Compare = std::less<Key>>
+class skip_list {
+	struct Node: list_hook {
+		template<typename... Args>
+		explicit Node(std::size_t height, Args&&... args): height_(static_cast<std::uint8_t>(height)), value_(std::forward<Args>(args)...) {}
+
+		Node** tower() noexcept { return reinterpret_cast<Node**>(reinterpret_cast<std::byte*>(this) + tower_offset); }
+
+		std::uint8_t height_;
+		std::pair<const Key, T> value_;
+	};
+
+	static constexpr std::size_t tower_offset = (sizeof(Node) + alignof(Node*) - 1) / alignof(Node*) * alignof(Node*);
+public:
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = std::pair<const Key, T>;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using size_type = std::size_t;
+	using key_compare = Compare;
+
+	static constexpr std::size_t max_height = 16;
+
+	// ============= Iterator ============= //
+
+	template<bool isConst>
+	class skip_iterator: public iterator_facade<skip_iterator<isConst>, std::conditional_t<isConst, const value_type, value_type>, std::bidirectional_iterator_tag> {
+		friend skip_list;
+	public:
+		using hook_pointer = std::conditional_t<isConst, const list_hook*, list_hook*>;
+		using reference = std::conditional_t<isConst, const value_type&, value_type&>;
+
+		skip_iterator() noexcept = default;
+		explicit skip_iterator(hook_pointer hook) noexcept: hook_(hook) {}
+
+		template<bool wasConst>
+		requires (isConst && !wasConst)
+		skip_iterator(const skip_iterator<wasConst>& other) noexcept: hook_(other.hook_) {}
+
+		reference dereference() const noexcept { return static_cast<std::conditional_t<isConst, const Node*, Node*>>(hook_)->value_; }
+		void increment() noexcept { hook_ = hook_->next_; }
+		void decrement() noexcept { hook_ = hook_->prev_; }
+
+		bool equal(const skip_iterator& rhs) const noexcept { return hook_ == rhs.hook_; }
+	private:
+		hook_pointer hook_ = nullptr;
+	};
+
+	using iterator = skip_iterator<false>;
+	using const_iterator = skip_iterator<true>;
+
+	// ==================================== //
+
+	explicit skip_list(const Compare& comp = Compare()): comp_(comp) {
+		resetLinks();
+	}
+
+	skip_list(std::initializer_list<value_type> ilist, const Compare& comp = Compare()): skip_list(comp) {
+		for(const auto& value : ilist) {
+			emplace(value);
+		}
+	}
+
+	skip_list(const skip_list& other): skip_list(other.comp_) {
+		for(const auto& value : other) {
+			emplace(value);
+		}
+	}
+
+	skip_list(skip_list&& other) noexcept: comp_(other.comp_) {
+		resetLinks();
+		stealFrom(other);
+	}
+
+	skip_list& operator=(const skip_list& other) {
+		if(this != &other) {
+			skip_list tmp(other);
+			*this = std::move(tmp);
+		}
+		return *this;
+	}
+
+	skip_list& operator=(skip_list&& other) noexcept {
+		if(this != &other) {
+			clear();
+			comp_ = other.comp_;
+			stealFrom(other);
+		}
+		return *this;
+	}
+
+	~skip_list() { clear(); }
+
+	iterator begin() noexcept { return iterator(head_.next_); }
+	const_iterator begin() const noexcept { return cbegin(); }
+	const_iterator cbegin() const noexcept { return const_iterator(head_.next_); }
+
+	iterator end() noexcept { return iterator(&head_); }
+	const_iterator end() const noexcept { return cend(); }
+	const_iterator cend() const noexcept { return const_iterator(&head_); }
+
+	size_type size() const noexcept { return size_; }
+	bool empty() const noexcept { return size_ == 0; }
+	key_compare key_comp() const { return comp_; }
+
+	// ============= Lookup ============= //
+
+	// First element whose key is not less than key.
+	iterator lower_bound(const Key& key) noexcept { return iterator(hookAfter(search<false>(key, nullptr))); }
+	const_iterator lower_bound(const Key& key) const noexcept { return const_iterator(hookAfter(search<false>(key, nullptr))); }
+
+	// First element whose key is greater than key.
+	iterator upper_bound(const Key& key) noexcept { return iterator(hookAfter(search<true>(key, nullptr))); }
+	const_iterator upper_bound(const Key& key) const noexcept { return const_iterator(hookAfter(search<true>(key, nullptr))); }
+
+	iterator find(const Key& key) noexcept {
+		iterator it = lower_bound(key);
+		return it != end() && !comp_(key, it->first) ? it : end();
+	}
+	const_iterator find(const Key& key) const noexcept {
+		const_iterator it = lower_bound(key);
+		return it != end() && !comp_(key, it->first) ? it : end();
+	}
+
+	bool contains(const Key& key) const noexcept { return find(key) != end(); }
+
+	std::pair<iterator, iterator> equal_range(const Key& key) noexcept { return {lower_bound(key), upper_bound(key)}; }
+	std::pair<const_iterator, const_iterator> equal_range(const Key& key) const noexcept { return {lower_bound(key), upper_bound(key)}; }
+
+	size_type count(const Key& key) const noexcept {
+		auto [first, last] = equal_range(key);
+		return static_cast<size_type>(std::distance(first, last));
+	}
+
+	// ============= Modifiers ============= //
+
+	// Builds value_type from args and links it after the elements with an equal key.
+	template<typename... Args>
+	iterator emplace(Args&&... args) {
+		const std::size_t height = randomHeight();
+		Node* node = createNode(height, std::forward<Args>(args)...);
+		const Key& key = node->value_.first;
+
+		std::array<Node*, max_height> preds;
+		if(size_ == 0 || !comp_(key, tails_[0]->value_.first)) {
+			preds = tails_;
+		} else {
+			search<true>(key, &preds);
+		}
+		if(height > height_) {
+			height_ = height;
+		}
+
+		list_hook* prev = preds[0] ? preds[0] : &head_;
+		node->prev_ = prev;
+		node->next_ = prev->next_;
+		prev->next_->prev_ = node;
+		prev->next_ = node;
+
+		for(std::size_t level = 1; level < height; ++level) {
+			Node*& link = forward(preds[level], level);
+			node->tower()[level - 1] = link;
+			link = node;
+		}
+		for(std::size_t level = 0; level < height; ++level) {
+			if(tails_[level] == preds[level]) {
+				tails_[level] = node;
+			}
+		}
+		++size_;
+		return iterator(node);
+	}
+
+	iterator insert(const value_type& value) { return emplace(value); }
+	iterator insert(value_type&& value) { return emplace(std::move(value)); }
+
+	iterator erase(const_iterator pos) noexcept {
+		Node* node = static_cast<Node*>(const_cast<list_hook*>(pos.hook_));
+		list_hook* next = node->next_;
+
+		if(node->height_ > 1) {
+			std::array<Node*, max_height> preds;
+			search<false>(node->value_.first, &preds);
+			for(std::size_t level = 1; level < node->height_; ++level) {
+				Node* pred = preds[level];
+				while(forward(pred, level) != node) {
+					pred = forward(pred, level);
+				}
+				forward(pred, level) = node->tower()[level - 1];
+				if(tails_[level] == node) {
+					tails_[level] = pred;
+				}
+			}
+			while(height_ > 1 && head_tower_[height_ - 1] == nullptr) {
+				--height_;
+			}
+		}
+		if(tails_[0] == node) {
+			tails_[0] = node->prev_ == &head_ ? nullptr : static_cast<Node*>(node->prev_);
+		}
+		node->prev_->next_ = next;
+		next->prev_ = node->prev_;
+
+		destroyNode(node);
+		--size_;
+		return iterator(next);
+	}
+
+	iterator erase(const_iterator first, const_iterator last) noexcept {
+		while(first != last) {
+			first = erase(first);
+		}
+		return iterator(const_cast<list_hook*>(last.hook_));
+	}
+
+	// Removes every element with an equal key.
+	size_type erase(const Key& key) noexcept {
+		auto [first, last] = equal_range(key);
+		size_type count = 0;
+		while(first != last) {
+			first = erase(first);
+			++count;
+		}
+		return count;
+	}
+
+	void clear() noexcept {
+		list_hook* curr = head_.next_;
+		while(curr != &head_) {
+			list_hook* next = curr->next_;
+			destroyNode(static_cast<Node*>(curr));
+			curr = next;
+		}
+		resetLinks();
+		size_ = 0;
+	}
+
+	void swap(skip_list& other) noexcept {
+		skip_list tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+private:
+	// Nodes are named by pointer, nullptr stands for the head.
+	Node*& forward(Node* pos, std::size_t level) noexcept { return pos ? pos->tower()[level - 1] : head_tower_[level]; }
+	Node* forward(Node* pos, std::size_t level) const noexcept { return pos ? pos->tower()[level - 1] : head_tower_[level]; }
+
+	Node* nextAt(Node* pos, std::size_t level) const noexcept {
+		if(level == 0) {
+			list_hook* hook = pos ? pos->next_ : head_.next_;
+			return hook == &head_ ? nullptr : static_cast<Node*>(hook);
+		}
+		return forward(pos, level);
+	}
+
+	list_hook* hookAfter(Node* pos) const noexcept { return pos ? pos->next_ : head_.next_; }
+
+	// Last node ordered before key on every level: keys less than key, or not
+	// greater than key when AfterEqual. Returns the level 0 predecessor.
+	template<bool AfterEqual>
+	Node* search(const Key& key, std::array<Node*, max_height>* preds) const noexcept {
+		Node* pos = nullptr;
+		for(std::size_t level = height_; level-- > 0;) {
+			for(Node* next = nextAt(pos, level); next; next = nextAt(pos, level)) {
+				const bool before = AfterEqual ? !comp_(key, next->value_.first) : comp_(next->value_.first, key);
+				if(!before) {
+					break;
+				}
+				pos = next;
+			}
+			if(preds) {
+				(*preds)[level] = pos;
+			}
+		}
+		if(preds) {
+			std::fill(preds->begin() + static_cast<std::ptrdiff_t>(height_), preds->end(), nullptr);
+		}
+		return pos;
+	}
+
+	std::size_t randomHeight() noexcept {
+		// Two random bits per level: each level is reached with probability 1/4.
+		const std::uint64_t bits = rng_() | (std::uint64_t{1} << (2 * (max_height - 1)));
+		return 1 + static_cast<std::size_t>(std::countr_zero(bits)) / 2;
+	}
+
+	node_pool& poolFor(std::size_t height) {
+		node_pool*& pool = pools_[height - 1];
+		if(!pool) {
+			if(!pool_set_) {
+				pool_set_ = std::make_unique<node_pool_set>();
+			}
+			pool = &pool_set_->poolFor(tower_offset + (height - 1) * sizeof(Node*), alignof(Node));
+		}
+		return *pool;
+	}
+
+	template<typename... Args>
+	Node* createNode(std::size_t height, Args&&... args) {
+		node_pool& pool = poolFor(height);
+		void* block = pool.allocate();
+		try {
+			return ::new(block) Node(height, std::forward<Args>(args)...);
+		} catch(...) {
+			pool.deallocate(block);
+			throw;
+		}
+	}
+
+	void destroyNode(Node* node) noexcept {
+		node_pool& pool = *pools_[node->height_ - 1];
+		std::destroy_at(node);
+		pool.deallocate(node);
+	}
+
+	void resetLinks() noexcept {
+		head_.next_ = &head_;
+		head_.prev_ = &head_;
+		head_tower_.fill(nullptr);
+		tails_.fill(nullptr);
+		height_ = 1;
+	}
+
+	// Takes the nodes and pools of other, this must be empty.
+	void stealFrom(skip_list& other) noexcept {
+		if(other.size_ != 0) {
+			head_.next_ = other.head_.next_;
+			head_.prev_ = other.head_.prev_;
+			head_.next_->prev_ = &head_;
+			head_.prev_->next_ = &head_;
+		}
+		head_tower_ = other.head_tower_;
+		tails_ = other.tails_;
+		height_ = other.height_;
+		size_ = std::exchange(other.size_, 0);
+		std::swap(pool_set_, other.pool_set_);
+		std::swap(pools_, other.pools_);
+		other.resetLinks();
+	}
+
+	list_hook head_;
+	std::array<Node*, max_height> head_tower_;
+	std::array<Node*, max_height> tails_;
+	std::size_t height_ = 1;
+	size_type size_{};
+	[[no_unique_address]] Compare comp_;
+	xoshiro256 rng_{0x9e3779b97f4a7c15ULL};
+	std::unique_ptr<node_pool_set> pool_set_;
+	std::array<node_pool*, max_height> pools_{};
+};
+
+} // namespace exp
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "iterator.hpp"
+
+namespace exp {
+
+// Structure of arrays: every Ts lives in its own contiguous column. All columns
+// share one allocation, one size and one capacity, each column starts on a
+// 64-byte boundary. Rows are tuples of references reached through zip_iterator.
+template<typename... Ts>
+class soa_vector {
+	static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+public:
+	using value_type = std::tuple<Ts...>;
+	using reference = zip_tuple<Ts&...>;
+	using const_reference = zip_tuple<const Ts&...>;
+	using iterator = zip_iterator<Ts*...>;
+	using const_iterator = zip_iterator<const Ts*...>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	template<std::size_t I>
+	using column_type = std::tuple_element_t<I, value_type>;
+
+	static constexpr std::size_t columns = sizeof...(Ts);
+	static constexpr std::size_t column_alignment = std::max({std::size_t{64}, alignof(Ts)...});
+	static constexpr size_type min_capacity = 8;
+
+	soa_vector() noexcept = default;
+
+	// The constructors below delegate to soa_vector() so that, should a column
+	// element throw, the destructor frees the block and the rows already built.
+	explicit soa_vector(size_type n): soa_vector() {
+		resize(n);
+	}
+
+	soa_vector(std::initializer_list<value_type> rows): soa_vector() {
+		reserve(rows.size());
+		for(const auto& row : rows) {
+			push_back(row);
+		}
+	}
+
+	soa_vector(const soa_vector& other): soa_vector() {
+		reserve(other.size_);
+		copyColumns(other, std::index_sequence_for<Ts...>{});
+		size_ = other.size_;
+	}
+
+	soa_vector(soa_vector&& other) noexcept:
+		block_(std::exchange(other.block_, nullptr)),
+		cols_(std::exchange(other.cols_, {})),
+		size_(std::exchange(other.size_, 0)),
+		capacity_(std::exchange(other.capacity_, 0)) {}
+
+	soa_vector& operator=(soa_vector other) noexcept {
+		swap(other);
+		return *this;
+	}
+
+	~soa_vector() {
+		clear();
+		::operator delete(block_, std::align_val_t{column_alignment});
+	}
+
+	iterator begin() noexcept { return std::apply([](auto*... cols) { return iterator(cols...); }, cols_); }
+	iterator end() noexcept { return begin() + static_cast<difference_type>(size_); }
+	const_iterator begin() const noexcept { return cbegin(); }
+	const_iterator end() const noexcept { return cend(); }
+	const_iterator cbegin() const noexcept { return std::apply([](auto*... cols) { return const_iterator(cols...); }, cols_); }
+	const_iterator cend() const noexcept { return cbegin() + static_cast<difference_type>(size_); }
+
+	size_type size() const noexcept { return size_; }
+	size_type capacity() const noexcept { return capacity_; }
+	bool empty() const noexcept { return size_ == 0; }
+
+	static constexpr size_type max_size() noexcept {
+		return (std::numeric_limits<std::ptrdiff_t>::max() - columns * column_alignment) / (sizeof(Ts) + ...);
+	}
+
+	reference operator[](size_type idx) noexcept {
+		return std::apply([idx](auto*... cols) { return reference(cols[idx]...); }, cols_);
+	}
+	const_reference operator[](size_type idx) const noexcept {
+		return std::apply([idx](auto*... cols) { return const_reference(cols[idx]...); }, cols_);
+	}
+
+	// Direct access to one column, contiguous and aligned to column_alignment.
+	template<std::size_t I>
+	std::span<column_type<I>> column() noexcept { return {std::get<I>(cols_), size_}; }
+	template<std::size_t I>
+	std::span<const column_type<I>> column() const noexcept { return {std::get<I>(cols_), size_}; }
+
+	template<std::size_t I>
+	column_type<I>* data() noexcept { return std::get<I>(cols_); }
+	template<std::size_t I>
+	const column_type<I>* data() const noexcept { return std::get<I>(cols_); }
+
+	// All columns as a zip_range, without the per-construction size check.
+	auto zip() noexcept {
+		return [this]<std::size_t... I>(std::index_sequence<I...>) {
+			return zip_range<std::span<Ts>...>(zip_unchecked, column<I>()...);
+		}(std::index_sequence_for<Ts...>{});
+	}
+
+	void reserve(size_type n) {
+		if(n > capacity_) {
+			reallocate(n);
+		}
+	}
+
+	void shrink_to_fit() {
+		if(size_ < capacity_) {
+			reallocate(size_);
+		}
+	}
+
+	// One value per column.
+	template<typename... Args>
+	requires (sizeof...(Args) == sizeof...(Ts))
+	reference emplace_back(Args&&... args) {
+		growIfFull();
+		constructRow(size_, std::forward_as_tuple(std::forward<Args>(args)...), std::index_sequence_for<Ts...>{});
+		return (*this)[size_++];
+	}
+
+	void push_back(const value_type& row) {
+		std::apply([this](const auto&... vals) { emplace_back(vals...); }, row);
+	}
+	void push_back(value_type&& row) {
+		std::apply([this](auto&... vals) { emplace_back(std::move(vals)...); }, row);
+	}
+
+	void pop_back() noexcept {
+		--size_;
+		destroyRows(size_, size_ + 1);
+	}
+
+	void resize(size_type n) {
+		if(n < size_) {
+			destroyRows(n, size_);
+			size_ = n;
+			return;
+		}
+		reserve(n);
+		while(size_ < n) {
+			constructRow(size_, std::tuple<>{}, std::index_sequence_for<Ts...>{});
+			++size_;
+		}
+	}
+
+	void clear() noexcept {
+		destroyRows(0, size_);
+		size_ = 0;
+	}
+
+	void swap(soa_vector& other) noexcept {
+		std::swap(block_, other.block_);
+		std::swap(cols_, other.cols_);
+		std::swap(size_, other.size_);
+		std::swap(capacity_, other.capacity_);
+	}
+
+	friend bool operator==(const soa_vector& lhs, const soa_vector& rhs) {
+		if(lhs.size_ != rhs.size_) {
+			return false;
+		}
+		return [&]<std::size_t... I>(std::index_sequence<I...>) {
+			return (std::equal(std::get<I>(lhs.cols_), std::get<I>(lhs.cols_) + lhs.size_, std::get<I>(rhs.cols_)) && ...);
+		}(std::index_sequence_for<Ts...>{});
+	}
+
+private:
+	static constexpr std::size_t roundUp(std::size_t value) noexcept {
+		return (value + column_alignment - 1) / column_alignment * column_alignment;
+	}
+
+	// Byte offset of every column in a block holding capacity rows, the last entry is the block size.
+	static std::array<std::size_t, columns + 1> layout(size_type capacity) noexcept {
+		constexpr std::size_t sizes[] = {sizeof(Ts)...};
+		std::array<std::size_t, columns + 1> offsets{};
+		for(std::size_t col = 0; col < columns; ++col) {
+			offsets[col + 1] = roundUp(offsets[col] + sizes[col] * capacity);
+		}
+		return offsets;
+	}
+
+	void growIfFull() {
+		if(size_ == capacity_) {
+			reallocate(std::max(min_capacity, capacity_ * 2));
+		}
+	}
+
+	// Moves every column into a new block. Elements that may throw on move are
+	// copied instead, so the vector is unchanged if that throws.
+	void reallocate(size_type new_capacity) {
+		if(new_capacity > max_size()) {
+			throw std::length_error("soa_vector capacity exceeds max_size()");
+		}
+		const auto offsets = layout(new_capacity);
+		auto* block = static_cast<std::byte*>(::operator new(offsets.back(), std::align_val_t{column_alignment}));
+		auto cols = [&]<std::size_t... I>(std::index_sequence<I...>) {
+			return std::tuple<Ts*...>(reinterpret_cast<Ts*>(block + offsets[I])...);
+		}(std::index_sequence_for<Ts...>{});
+
+		try {
+			relocateColumns(cols, std::index_sequence_for<Ts...>{});
+		} catch(...) {
+			::operator delete(block, std::align_val_t{column_alignment});
+			throw;
+		}
+
+		destroyRows(0, size_);
+		::operator delete(block_, std::align_val_t{column_alignment});
+		block_ = block;
+		cols_ = cols;
+		capacity_ = new_capacity;
+	}
+
+	template<typename T>
+	static constexpr bool relocate_may_throw = !std::is_nothrow_move_constructible_v<T> && std::is_copy_constructible_v<T>;
+
+	// Columns that copy go first, nothing is moved from until the last copy succeeded.
+	template<std::size_t... I>
+	void relocateColumns(std::tuple<Ts*...>& cols, std::index_sequence<I...>) {
+		std::array<bool, columns> copied{};
+		try {
+			((relocate_may_throw<Ts> ? (std::uninitialized_copy_n(std::get<I>(cols_), size_, std::get<I>(cols)), copied[I] = true) : false), ...);
+		} catch(...) {
+			((copied[I] ? (void)std::destroy_n(std::get<I>(cols), size_) : void()), ...);
+			throw;
+		}
+		((relocate_may_throw<Ts> ? void() : (void)std::uninitialized_move_n(std::get<I>(cols_), size_, std::get<I>(cols))), ...);
+	}
+
+	template<std::size_t... I>
+	void copyColumns(const soa_vector& other, std::index_sequence<I...>) {
+		std::size_t done = 0;
+		try {
+			((std::uninitialized_copy_n(std::get<I>(other.cols_), other.size_, std::get<I>(cols_)), ++done), ...);
+		} catch(...) {
+			((I < done ? (void)std::destroy_n(std::get<I>(cols_), other.size_) : void()), ...);
+			throw;
+		}
+	}
+
+	// Builds row idx, column I from get<I>(args) or value-initialized when args is empty.
+	template<typename Tuple, std::size_t... I>
+	void constructRow(size_type idx, Tuple&& args, std::index_sequence<I...>) {
+		std::size_t done = 0;
+		try {
+			if constexpr (std::tuple_size_v<std::remove_cvref_t<Tuple>> == 0) {
+				((std::construct_at(std::get<I>(cols_) + idx), ++done), ...);
+			} else {
+				((std::construct_at(std::get<I>(cols_) + idx, std::get<I>(std::forward<Tuple>(args))), ++done), ...);
+			}
+		} catch(...) {
+			((I < done ? std::destroy_at(std::get<I>(cols_) + idx) : void()), ...);
+			throw;
+		}
+	}
+
+	void destroyRows(size_type first, size_type last) noexcept {
+		std::apply([first, last](auto*... cols) { (std::destroy(cols + first, cols + last), ...); }, cols_);
+	}
+
+	void* block_ = nullptr;
+	std::tuple<Ts*...> cols_{};
+	size_type size_{};
+	size_type capacity_{};
+};
+
+} // namespace exp
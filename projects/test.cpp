@@ -1,7 +1,33 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <list>
+#include <deque>
+#include <sstream>
+#include <string>
+#include <iterator>
+#include <algorithm>
 #include "list.hpp"
+#include "pool_allocator.hpp"
+#include "unrolled_list.hpp"
+#include "compact_list.hpp"
+#include "ring_deque.hpp"
+#include "concurrent_list.hpp"
+#include "concurrent_hash_map.hpp"
+#include "parallel_reduce.hpp"
+#include "work_stealing_pool.hpp"
+#include "parallel_algorithms.hpp"
+#include "zip_kernels.hpp"
+#include "soa_vector.hpp"
+#include "intrusive_list.hpp"
+#include "instrumentation.hpp"
+#include "allocation_stats.hpp"
+#include "adaptors.hpp"
+#include "skip_list.hpp"
+#include "lru_cache.hpp"
+#include "mapped_list.hpp"
+#include "chunk_stream.hpp"
+#include <thread>
+#include <numeric>
 
 struct ObjectWithExceptions {
     ObjectWithExceptions() {
@@ -207,44 +233,1739 @@ TEST(list, strong_exception_garantee_push_back) {
     ObjectWithExceptions::cnt = 0;
 }
 
-// TEST(list, strong_exception_garantee_ctor) {
-//     exp::list<ObjectWithExceptions> list(3);
+TEST(list, splice_whole_list) {
+    exp::list<int> list1 = {1,2,3};
+    exp::list<int> list2 = {4,5};
+    auto pos = list1.begin();
+    ++pos;
 
-//     EXPECT_EQ(list.size(), 0);
-//     ObjectWithExceptions::cnt = 0;
-// }
-// TEST(list, strong_exception_garantee_init_ctor) {
-//     exp::list<ObjectWithExceptions> list = {{}, {}, {}};
+    list1.splice(pos, list2);
 
-//     EXPECT_EQ(list.size(), 0);
-//     ObjectWithExceptions::cnt = 0;
-// }
+    EXPECT_EQ(list1, exp::list<int>({1,4,5,2,3}));
+    EXPECT_EQ(list1.size(), 5);
+    EXPECT_EQ(list2.size(), 0);
+    EXPECT_EQ(list2.begin(), list2.end());
+}
+
+TEST(list, splice_element_and_range) {
+    exp::list<int> list1 = {1,2,3};
+    exp::list<int> list2 = {4,5,6,7};
+
+    auto first = list2.begin();
+    ++first;
+    list1.splice(list1.end(), list2, first);
+    EXPECT_EQ(list1, exp::list<int>({1,2,3,5}));
+    EXPECT_EQ(list2.size(), 3);
+
+    first = list2.begin();
+    auto last = list2.end();
+    --last;
+    list1.splice(list1.begin(), list2, first, last);
+    EXPECT_EQ(list1, exp::list<int>({4,6,1,2,3,5}));
+    EXPECT_EQ(list1.size(), 6);
+    EXPECT_EQ(list2, exp::list<int>({7}));
+    EXPECT_EQ(list2.size(), 1);
+
+    list1.splice(list1.begin(), list1, --list1.end());
+    EXPECT_EQ(list1, exp::list<int>({5,4,6,1,2,3}));
+    EXPECT_EQ(list1.size(), 6);
+}
+
+TEST(list, merge) {
+    exp::list<int> list1 = {1,3,5,7};
+    exp::list<int> list2 = {0,2,3,8,9};
+
+    list1.merge(list2);
+
+    EXPECT_EQ(list1, exp::list<int>({0,1,2,3,3,5,7,8,9}));
+    EXPECT_EQ(list1.size(), 9);
+    EXPECT_EQ(list2.size(), 0);
+    EXPECT_EQ(*--list1.end(), 9);
+}
+
+TEST(list, sort_matches_std_list) {
+    std::vector<int> values(1000);
+    for(size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>((i * 7919) % 263);
+    }
+    exp::list<int> list(values.begin(), values.end());
+    std::list<int> ref(values.begin(), values.end());
+
+    list.sort();
+    ref.sort();
+
+    EXPECT_TRUE(std::equal(list.begin(), list.end(), ref.begin(), ref.end()));
+    EXPECT_TRUE(std::equal(std::reverse_iterator(list.end()), std::reverse_iterator(list.begin()), ref.rbegin(), ref.rend()));
+    EXPECT_EQ(list.size(), ref.size());
+}
+
+TEST(list, sort_is_stable) {
+    exp::list<std::pair<int, int>> list;
+    for(int i = 0; i < 100; ++i) {
+        list.push_back({i % 5, i});
+    }
+
+    list.sort([](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    auto prev = *list.begin();
+    for(auto it = ++list.begin(); it != list.end(); ++it) {
+        EXPECT_TRUE(prev.first < it->first || (prev.first == it->first && prev.second < it->second));
+        prev = *it;
+    }
+}
+
+TEST(list, sort_keeps_elements_when_compare_throws) {
+    exp::list<int> list = {5,4,3,2,1,0,9,8,7,6};
+    int calls = 0;
+
+    EXPECT_THROW(list.sort([&calls](int lhs, int rhs) {
+        if(++calls == 10) {
+            throw std::runtime_error("compare");
+        }
+        return lhs < rhs;
+    }), std::runtime_error);
+
+    std::vector<int> values(list.begin(), list.end());
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, std::vector<int>({0,1,2,3,4,5,6,7,8,9}));
+    EXPECT_EQ(std::distance(std::reverse_iterator(list.end()), std::reverse_iterator(list.begin())), 10);
+}
+
+TEST(list, reverse_and_unique) {
+    exp::list<int> list = {1,1,2,3,3,3,4};
+
+    EXPECT_EQ(list.unique(), 3);
+    EXPECT_EQ(list, exp::list<int>({1,2,3,4}));
+
+    list.reverse();
+    EXPECT_EQ(list, exp::list<int>({4,3,2,1}));
+    EXPECT_EQ(*--list.end(), 1);
+    EXPECT_EQ(list.size(), 4);
+}
+
+TEST(list, strong_exception_garantee_ctor) {
+    EXPECT_THROW(exp::list<ObjectWithExceptions> list(5), std::runtime_error);
+    ObjectWithExceptions::cnt = 0;
+
+    exp::list<ObjectWithExceptions> list(3);
+    EXPECT_EQ(list.size(), 3);
+    ObjectWithExceptions::cnt = 0;
+}
+
+TEST(list, strong_exception_garantee_bulk_insert) {
+    exp::list<ObjectWithExceptions, exp::pool_allocator<ObjectWithExceptions>> list(2);
+
+    EXPECT_THROW(list.emplace_back_n(5), std::runtime_error);
+    EXPECT_EQ(list.size(), 2);
+    EXPECT_EQ(std::distance(list.begin(), list.end()), 2);
+    ObjectWithExceptions::cnt = 0;
+}
+
+TEST(list, it_ctor) {
+    std::vector vec {1,2,3,4};
+
+    exp::list list(vec.begin(), vec.end());
+
+    exp::list list1 {1,2,3,4};
+    EXPECT_EQ(list, list1);
+    EXPECT_EQ(list.size(), 4);
+}
+
+TEST(list, bulk_insert) {
+    exp::list<int> list = {1,5};
+    std::vector<int> vec = {2,3,4};
+    auto pos = list.begin();
+    ++pos;
+
+    auto it = list.insert(pos, vec.begin(), vec.end());
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(list, exp::list<int>({1,2,3,4,5}));
+
+    list.insert(list.begin(), 2, 0);
+    list.append_range(std::vector<int>{6,7});
+    list.emplace_back_n(2, 8);
+    EXPECT_EQ(list, exp::list<int>({0,0,1,2,3,4,5,6,7,8,8}));
+    EXPECT_EQ(list.size(), 11);
+    EXPECT_EQ(*--list.end(), 8);
+
+    std::istringstream input("9 10");
+    list.insert(list.end(), std::istream_iterator<int>(input), std::istream_iterator<int>());
+    EXPECT_EQ(list.size(), 13);
+    EXPECT_EQ(*--list.end(), 10);
+}
+
+TEST(list, bulk_insert_pool_allocator_is_contiguous) {
+    exp::list<int, exp::pool_allocator<int>> list;
+    list.emplace_back_n(1000, 7);
+
+    auto it = list.begin();
+    const auto* first = reinterpret_cast<const std::byte*>(&*it);
+    const auto stride = reinterpret_cast<const std::byte*>(&*++it) - first;
+    EXPECT_GT(stride, 0);
+    for(std::ptrdiff_t idx = 1; it != list.end(); ++it, ++idx) {
+        EXPECT_EQ(reinterpret_cast<const std::byte*>(&*it) - first, idx * stride);
+    }
+    list.pop_front();
+    list.push_back(1);
+    EXPECT_EQ(list.size(), 1000);
+}
+
+TEST(list, copy_ctor) {
+    exp::list list {1,2,3,4};
+
+    auto list1 = list;
+
+    EXPECT_EQ(list, list1);
+    EXPECT_EQ(list1.size(), 4);
+}
+
+TEST(list, move_ctor) {
+    exp::list list {1,2,3,4};
+    exp::list ref_list {1,2,3,4};
+
+    auto list1 = std::move(list);
+
+    EXPECT_EQ(list1, ref_list);
+    EXPECT_EQ(list.size(), 0);
+    EXPECT_EQ(list.begin(), list.end());
+    list.push_back(5);
+    EXPECT_EQ(list, exp::list<int>({5}));
+}
+
+TEST(list, swap) {
+    exp::list<int> list1 = {1,2,3};
+    exp::list<int> list2;
+    auto first = list1.begin();
+
+    swap(list1, list2);
+    EXPECT_EQ(list1.size(), 0);
+    EXPECT_EQ(list2, exp::list<int>({1,2,3}));
+    EXPECT_EQ(first, list2.begin());
+    list1.push_back(4);
+    EXPECT_EQ(list1, exp::list<int>({4}));
+}
+
+TEST(list, extract_and_insert_node) {
+    using alloc = exp::stats_allocator<std::string>;
+    auto& stats = exp::allocation_registry::global().get("test.node_handle");
+    exp::list<std::string, alloc> list1({"a", "b", "c"}, alloc(stats));
+    exp::list<std::string, alloc> list2{alloc(stats)};
+    const auto allocations = stats.snapshot().allocations_;
+
+    auto node = list1.extract(std::next(list1.begin()));
+    EXPECT_FALSE(node.empty());
+    EXPECT_EQ(node.value(), "b");
+    EXPECT_EQ(list1.size(), 2);
+    node.value() += "!";
+
+    auto it = list2.insert(list2.end(), std::move(node));
+    EXPECT_TRUE(node.empty());
+    EXPECT_EQ(*it, "b!");
+    EXPECT_EQ(list2.insert(list2.end(), std::move(node)), list2.end());
+    EXPECT_EQ(list2.size(), 1);
+    EXPECT_EQ(stats.snapshot().allocations_, allocations);
+
+    {
+        auto dropped = list1.extract(list1.begin());
+    }
+    EXPECT_EQ(stats.snapshot().live_objects_, 2);
+    EXPECT_EQ(list1, (exp::list<std::string, alloc>({"c"}, alloc(stats))));
+
+    exp::small_list<std::string, 2> small = {"x", "y", "z"};
+    auto inline_node = small.extract(small.begin());
+    small.push_back("w");
+    EXPECT_EQ(inline_node.value(), "x");
+    EXPECT_EQ(small, (exp::small_list<std::string, 2>({"y", "z", "w"})));
+}
+
+TEST(list, assignment_reuses_nodes) {
+    using alloc = exp::stats_allocator<int>;
+    auto& stats = exp::allocation_registry::global().get("test.list_assign");
+    exp::list<int, alloc> dst{alloc(stats)};
+    dst.emplace_back_n(10, 0);
+    exp::list<int, alloc> src{alloc(stats)};
+    for(int i = 0; i < 12; ++i) {
+        src.push_back(i);
+    }
+
+    auto before = stats.snapshot();
+    dst = src;
+    EXPECT_EQ(dst, src);
+    EXPECT_EQ(stats.snapshot().allocations_ - before.allocations_, 2);
+
+    before = stats.snapshot();
+    dst.assign({7, 8, 9});
+    EXPECT_EQ(stats.snapshot().allocations_, before.allocations_);
+    EXPECT_EQ(stats.snapshot().deallocations_ - before.deallocations_, 9);
+    EXPECT_EQ(dst, (exp::list<int, alloc>({7, 8, 9}, alloc(stats))));
+
+    dst.assign(4, 1);
+    EXPECT_EQ(dst, (exp::list<int, alloc>({1, 1, 1, 1}, alloc(stats))));
+
+    dst = std::move(src);
+    EXPECT_EQ(dst.size(), 12);
+    EXPECT_EQ(src.size(), 0);
+    src = {1, 2};
+    EXPECT_EQ(src, (exp::list<int, alloc>({1, 2}, alloc(stats))));
+
+    exp::small_list<std::string, 4> small = {"a", "b"};
+    exp::small_list<std::string, 4> other = {"c", "d", "e", "f", "g"};
+    small = std::move(other);
+    EXPECT_EQ(small, (exp::small_list<std::string, 4>({"c", "d", "e", "f", "g"})));
+    other = small;
+    EXPECT_EQ(other, small);
+}
+
+TEST(small_list, short_lists_do_not_allocate) {
+    using alloc = exp::stats_allocator<std::uint64_t>;
+    auto& stats = exp::allocation_registry::global().get("test.small_list");
+    const auto before = stats.snapshot();
+    {
+        exp::small_list<std::uint64_t, 4, alloc> list(alloc("test.small_list"));
+        for(std::uint64_t i = 0; i < 4; ++i) {
+            list.push_back(i);
+        }
+        EXPECT_EQ(stats.snapshot().allocations_, before.allocations_);
+
+        list.emplace_back_n(2, 7);
+        list.push_front(9);
+        EXPECT_EQ(stats.snapshot().allocations_ - before.allocations_, 3);
+        EXPECT_EQ(list, (exp::small_list<std::uint64_t, 4, alloc>{9, 0, 1, 2, 3, 7, 7}));
+
+        list.pop_front();
+        list.pop_front();
+        list.push_back(5);
+        EXPECT_EQ(stats.snapshot().allocations_ - before.allocations_, 3);
+    }
+    const auto snap = stats.snapshot();
+    EXPECT_EQ(snap.live_objects_, 0);
+    EXPECT_EQ(snap.allocations_, snap.deallocations_);
+}
+
+TEST(small_list, move_and_swap_keep_elements) {
+    using list = exp::small_list<std::string, 4>;
+    list list1 = {"a", "b", "c", "d", "e", "f"};
+    list list2 = {"x", "y"};
+
+    list1.swap(list2);
+    EXPECT_EQ(list1, list({"x", "y"}));
+    EXPECT_EQ(list2, list({"a", "b", "c", "d", "e", "f"}));
+
+    list list3(std::move(list2));
+    EXPECT_EQ(list2.size(), 0);
+    EXPECT_EQ(list3, list({"a", "b", "c", "d", "e", "f"}));
+    EXPECT_EQ(*std::prev(list3.end()), "f");
+
+    list2.push_back("z");
+    swap(list2, list3);
+    EXPECT_EQ(list2, list({"a", "b", "c", "d", "e", "f"}));
+    EXPECT_EQ(list3, list({"z"}));
+}
+
+TEST(small_list, splice_and_merge_take_inline_nodes) {
+    using list = exp::small_list<int, 4>;
+    list list1 = {1, 3, 5, 7, 9};
+    list list2 = {0, 2, 4};
+
+    list1.merge(list2);
+    EXPECT_EQ(list1, list({0, 1, 2, 3, 4, 5, 7, 9}));
+    EXPECT_EQ(list2.size(), 0);
+
+    list2.splice(list2.end(), list1, list1.begin());
+    list2.splice(list2.end(), list1, std::next(list1.begin(), 2), std::next(list1.begin(), 5));
+    EXPECT_EQ(list1, list({1, 2, 7, 9}));
+    EXPECT_EQ(list2, list({0, 3, 4, 5}));
+
+    list1.splice(list1.begin(), list2);
+    EXPECT_EQ(list1, list({0, 3, 4, 5, 1, 2, 7, 9}));
+    EXPECT_EQ(list2.size(), 0);
+    list1.sort();
+    EXPECT_EQ(list1, list({0, 1, 2, 3, 4, 5, 7, 9}));
+}
+
+TEST(stats_allocator, list_node_counters) {
+    auto& stats = exp::allocation_registry::global().get("test.list");
+    const auto before = stats.snapshot();
+    {
+        exp::list<std::uint64_t, exp::stats_allocator<std::uint64_t>> list(exp::stats_allocator<std::uint64_t>("test.list"));
+        for(std::uint64_t i = 0; i < 10; ++i) {
+            list.push_back(i);
+        }
+        list.pop_front();
+
+        auto snap = stats.snapshot();
+        EXPECT_EQ(snap.live_objects_, 9);
+        EXPECT_EQ(snap.peak_objects_, 10);
+        EXPECT_EQ(snap.allocations_ - before.allocations_, 10);
+        EXPECT_EQ(snap.deallocations_ - before.deallocations_, 1);
+        EXPECT_EQ(snap.payload_bytes_, 9 * sizeof(std::uint64_t));
+        EXPECT_EQ(snap.live_bytes_ - snap.payload_bytes_, 9 * 2 * sizeof(void*));
+
+        auto copy = list;
+        EXPECT_EQ(stats.snapshot().live_objects_, 18);
+    }
+    auto snap = stats.snapshot();
+    EXPECT_EQ(snap.live_objects_, 0);
+    EXPECT_EQ(snap.live_bytes_, 0);
+    EXPECT_EQ(snap.allocations_, snap.deallocations_);
+}
+
+TEST(stats_allocator, default_constructed_reports_to_default_entry) {
+    auto& stats = exp::allocation_registry::global().get("default");
+    EXPECT_EQ(&exp::stats_allocator<int>().stats(), &stats);
+    EXPECT_EQ(&exp::stats_allocator<double>().stats(), &stats);
+    EXPECT_EQ(exp::stats_allocator<int>(), exp::stats_allocator<int>("default"));
+}
+
+TEST(stats_allocator, bulk_over_pool_and_registry_dump) {
+    using alloc = exp::stats_allocator<int, exp::pool_allocator<int>>;
+    exp::unrolled_list<int, 64, alloc> chunks(alloc("test.unrolled"));
+    exp::list<int, alloc> list(alloc("test.pool_list"));
+    list.emplace_back_n(100, 1);
+    for(int i = 0; i < 32; ++i) {
+        chunks.push_back(i);
+    }
+
+    auto& list_stats = exp::allocation_registry::global().get("test.pool_list");
+    EXPECT_EQ(list_stats.snapshot().live_objects_, 100);
+    EXPECT_EQ(list_stats.snapshot().peak_objects_, 100);
+    auto chunk_snap = exp::allocation_registry::global().get("test.unrolled").snapshot();
+    EXPECT_EQ(chunk_snap.live_objects_, 2);
+    EXPECT_EQ(chunk_snap.payload_bytes_, 2 * 64);
+
+    std::ostringstream os;
+    exp::allocation_registry::global().dump(os);
+    EXPECT_NE(os.str().find("test.pool_list | 100 | 100 |"), std::string::npos);
+}
+
+struct session {
+    int id;
+    exp::list_hook lru_hook;
+    exp::list_hook idle_hook;
+};
+
+TEST(intrusive_list, link_unlink) {
+    std::vector<session> sessions(5);
+    exp::intrusive_list<session, &session::lru_hook> lru;
+    for(int i = 0; i < 5; ++i) {
+        sessions[i].id = i;
+        lru.push_back(sessions[i]);
+    }
+    EXPECT_EQ(lru.size(), 5);
+    EXPECT_TRUE(sessions[2].lru_hook.is_linked());
+
+    lru.remove(sessions[2]);
+    EXPECT_FALSE(sessions[2].lru_hook.is_linked());
+    lru.push_front(sessions[2]);
+
+    std::vector<int> ids;
+    for(const auto& s : lru) {
+        ids.push_back(s.id);
+    }
+    EXPECT_EQ(ids, std::vector({2,0,1,3,4}));
+    EXPECT_EQ(lru.back().id, 4);
+    EXPECT_EQ((--lru.end())->id, 4);
+}
+
+TEST(intrusive_list, object_in_two_lists) {
+    std::vector<session> sessions(4);
+    exp::intrusive_list<session, &session::lru_hook> lru;
+    exp::intrusive_list<session, &session::idle_hook> idle;
+    for(int i = 0; i < 4; ++i) {
+        sessions[i].id = i;
+        lru.push_back(sessions[i]);
+        idle.push_front(sessions[i]);
+    }
+
+    idle.remove(sessions[1]);
+    EXPECT_EQ(idle.size(), 3);
+    EXPECT_EQ(lru.size(), 4);
+    EXPECT_EQ(idle.front().id, 3);
+
+    exp::intrusive_list<session, &session::lru_hook> hot;
+    hot.splice(hot.end(), lru, lru.iterator_to(sessions[3]));
+    EXPECT_EQ(hot.front().id, 3);
+    EXPECT_EQ(lru.size(), 3);
+
+    auto moved = std::move(lru);
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_TRUE(lru.empty());
+    moved.clear();
+    EXPECT_FALSE(sessions[0].lru_hook.is_linked());
+    EXPECT_TRUE(sessions[0].idle_hook.is_linked());
+}
+
+struct counted_session {
+    explicit counted_session(std::string name): name(std::move(name)) { ++constructed; }
+    std::string name;
+    exp::list_hook hook;
+    inline static int constructed = 0;
+};
+
+TEST(intrusive_list, hook_offset_without_default_constructor) {
+    std::vector<counted_session> sessions;
+    sessions.reserve(3);
+    for(const char* name : {"a", "b", "c"}) {
+        sessions.emplace_back(name);
+    }
+    exp::intrusive_list<counted_session, &counted_session::hook> list;
+    for(auto& session : sessions) {
+        list.push_front(session);
+    }
+    EXPECT_EQ(list.front().name, "c");
+    EXPECT_EQ(list.back().name, "a");
+    EXPECT_EQ(&*list.iterator_to(sessions[1]), &sessions[1]);
+    EXPECT_EQ(counted_session::constructed, 3);
+}
+
+TEST(node_pool, reuses_freed_block) {
+    exp::node_pool pool(sizeof(int), alignof(int));
+    void* first = pool.allocate();
+    void* second = pool.allocate();
+    EXPECT_NE(first, second);
+
+    pool.deallocate(first);
+    EXPECT_EQ(pool.allocate(), first);
+    EXPECT_EQ(pool.slab_count(), 1);
+}
+
+TEST(node_pool, contiguous_blocks) {
+    exp::node_pool pool(24, 8);
+    auto* first = static_cast<std::byte*>(pool.allocate());
+    auto* second = static_cast<std::byte*>(pool.allocate());
+    EXPECT_EQ(second - first, 24);
+}
+
+TEST(node_pool, allocate_bulk) {
+    exp::node_pool pool(16, 8);
+    pool.allocate();
+    auto* blocks = static_cast<std::byte*>(pool.allocate_bulk(100));
+    EXPECT_EQ(pool.slab_count(), 2);
+
+    pool.deallocate(blocks + 16);
+    EXPECT_EQ(pool.allocate(), blocks + 16);
+}
+
+TEST(pool_allocator, rebind_equality) {
+    exp::pool_allocator<int> alloc;
+    exp::pool_allocator<double> rebound(alloc);
+    exp::pool_allocator<int> other;
+
+    EXPECT_TRUE(alloc == exp::pool_allocator<int>(rebound));
+    EXPECT_TRUE(exp::pool_allocator<double>(alloc) == rebound);
+    EXPECT_FALSE(alloc == other);
+}
+
+TEST(list, pool_allocator) {
+    exp::list<int, exp::pool_allocator<int>> list = {1,2,3,4};
+    list.erase(list.begin());
+    list.push_back(5);
+    list.push_front(0);
+
+    std::vector<int> actual(list.begin(), list.end());
+    std::vector<int> expected = {0,2,3,4,5};
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(list, pool_allocator_copy_has_own_pool) {
+    exp::list<int, exp::pool_allocator<int>> list = {1,2,3};
+    exp::list<int, exp::pool_allocator<int>> copy(list);
+
+    EXPECT_EQ(list, copy);
+    EXPECT_FALSE(list.get_allocator() == copy.get_allocator());
+}
+
+TEST(unrolled_list, push_back_across_chunks) {
+    exp::unrolled_list<int, 16> list;
+    for(int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+
+    EXPECT_EQ(list.size(), 10);
+    std::vector<int> actual(list.begin(), list.end());
+    std::vector<int> expected = {0,1,2,3,4,5,6,7,8,9};
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(list.back(), 9);
+}
+
+TEST(unrolled_list, push_front) {
+    exp::unrolled_list<int, 16> list;
+    for(int i = 0; i < 10; ++i) {
+        list.push_front(i);
+    }
+
+    std::vector<int> actual(list.begin(), list.end());
+    std::vector<int> expected = {9,8,7,6,5,4,3,2,1,0};
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(unrolled_list, insert_into_full_chunk) {
+    exp::unrolled_list<int, 16> list = {1,2,3,4};
+    auto it = list.insert(std::next(list.begin(), 2), 42);
+
+    EXPECT_EQ(*it, 42);
+    std::vector<int> actual(list.begin(), list.end());
+    std::vector<int> expected = {1,2,42,3,4};
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(unrolled_list, iter_decrement) {
+    exp::unrolled_list<int, 8> list = {1,2,3,4,5};
+
+    std::vector<int> actual;
+    for(auto it = list.end(); it != list.begin();) {
+        actual.push_back(*--it);
+    }
+    std::vector<int> expected = {5,4,3,2,1};
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(unrolled_list, erase) {
+    exp::unrolled_list<int, 16> list = {1,2,3,4,5,6,7,8,9};
+
+    auto it = list.erase(std::next(list.begin(), 3));
+    EXPECT_EQ(*it, 5);
+    it = list.erase(std::prev(list.end()));
+    EXPECT_EQ(it, list.end());
+    list.pop_front();
+
+    std::vector<int> actual(list.begin(), list.end());
+    std::vector<int> expected = {2,3,5,6,7,8};
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(list.size(), 6);
+}
+
+TEST(unrolled_list, matches_std_list) {
+    exp::unrolled_list<std::string, 64> list;
+    std::list<std::string> ref;
+
+    for(int i = 0; i < 200; ++i) {
+        auto pos = i % 7;
+        auto it = list.begin();
+        auto ref_it = ref.begin();
+        for(int step = 0; step < pos && it != list.end(); ++step, ++it, ++ref_it) {}
+
+        if(i % 5 == 4 && it != list.end()) {
+            list.erase(it);
+            ref.erase(ref_it);
+        } else {
+            list.insert(it, std::to_string(i));
+            ref.insert(ref_it, std::to_string(i));
+        }
+    }
+
+    EXPECT_EQ(list.size(), ref.size());
+    EXPECT_TRUE(std::equal(list.begin(), list.end(), ref.begin(), ref.end()));
+}
+
+TEST(unrolled_list, copy_and_move) {
+    exp::unrolled_list<int, 16> list = {1,2,3,4,5,6};
+    auto copy = list;
+    EXPECT_EQ(copy, list);
+
+    auto moved = std::move(list);
+    EXPECT_EQ(moved, copy);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+
+    list = copy;
+    EXPECT_EQ(list, copy);
+    copy.push_back(7);
+    moved = std::move(copy);
+    EXPECT_EQ(moved, (exp::unrolled_list<int, 16>{1,2,3,4,5,6,7}));
+    list = exp::unrolled_list<int, 16>{};
+    EXPECT_TRUE(list.empty());
+    list.push_back(1);
+    EXPECT_EQ(*list.begin(), 1);
+}
+
+TEST(unrolled_list, insert_element_of_the_split_chunk) {
+    exp::unrolled_list<std::string, 4 * sizeof(std::string)> list;
+    for(char ch : {'a', 'b', 'c', 'd'}) {
+        list.push_back(std::string(32, ch));
+    }
+    // The chunk is full, so the insertion splits it and moves "ddd..." away.
+    list.insert(std::next(list.begin()), *std::prev(list.end()));
+    EXPECT_EQ((std::vector<std::string>(list.begin(), list.end())),
+              (std::vector<std::string>{std::string(32, 'a'), std::string(32, 'd'), std::string(32, 'b'),
+                                        std::string(32, 'c'), std::string(32, 'd')}));
+}
+
+TEST(unrolled_list, throwing_constructor_leaves_no_empty_chunk) {
+    // One element per chunk, so every insertion needs a new chunk.
+    exp::unrolled_list<ObjectWithExceptions, 1> objects;
+    objects.emplace_back();
+    objects.emplace_back();
+    objects.emplace_back();
+    EXPECT_THROW(objects.emplace_back(), std::runtime_error);
+    EXPECT_THROW(objects.emplace_front(), std::runtime_error);
+    EXPECT_THROW(objects.emplace(std::next(objects.begin())), std::runtime_error);
+    EXPECT_EQ(objects.size(), 3);
+    EXPECT_EQ(std::distance(objects.begin(), objects.end()), 3);
+    EXPECT_EQ(std::distance(objects.begin(), std::prev(objects.end())), 2);
+    ObjectWithExceptions::cnt = 0;
+}
+
+TEST(compact_list, matches_std_list) {
+    exp::compact_list<std::string> list;
+    std::list<std::string> ref;
+
+    for(int i = 0; i < 5000; ++i) {
+        auto pos = i % 7;
+        auto it = list.begin();
+        auto ref_it = ref.begin();
+        for(int step = 0; step < pos && it != list.end(); ++step, ++it, ++ref_it) {}
+
+        if(i % 3 == 2 && it != list.end()) {
+            list.erase(it);
+            ref.erase(ref_it);
+        } else {
+            list.insert(it, std::to_string(i));
+            ref.insert(ref_it, std::to_string(i));
+        }
+    }
+
+    for(std::size_t i = list.size(), last = list.capacity(); i <= last; ++i) {
+        list.push_back(list.front());
+        ref.push_back(ref.front());
+    }
+
+    EXPECT_EQ(list.size(), ref.size());
+    EXPECT_TRUE(std::equal(list.begin(), list.end(), ref.begin(), ref.end()));
+    EXPECT_TRUE(std::equal(list.rbegin(), list.rend(), ref.rbegin(), ref.rend()));
+}
+
+TEST(compact_list, reuses_erased_slots) {
+    static_assert(sizeof(exp::compact_list<int>::Node) == 3 * sizeof(std::uint32_t));
+    exp::compact_list<int> list;
+    list.reserve(100);
+    const auto capacity = list.capacity();
+    for(int round = 0; round < 50; ++round) {
+        for(int i = 0; i < 100; ++i) {
+            list.push_front(i);
+        }
+        while(!list.empty()) {
+            list.pop_back();
+        }
+    }
+    EXPECT_EQ(list.capacity(), capacity);
+
+    list = {1, 2, 3};
+    list.emplace(std::next(list.begin()), 7);
+    EXPECT_EQ(list, exp::compact_list<int>({1, 7, 2, 3}));
+    EXPECT_EQ(list.front(), 1);
+    EXPECT_EQ(list.back(), 3);
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+}
+
+TEST(compact_list, copy_move_and_exceptions) {
+    exp::compact_list<int> list = {1, 2, 3, 4, 5, 6};
+    list.erase(list.begin());
+    list.push_front(0);
+    auto copy = list;
+    EXPECT_EQ(copy, list);
+
+    auto moved = std::move(list);
+    EXPECT_EQ(moved, copy);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+    list.push_back(1);
+    EXPECT_EQ(list, exp::compact_list<int>({1}));
+
+    exp::compact_list<ObjectWithExceptions> objects;
+    objects.emplace_back();
+    objects.emplace_back();
+    objects.emplace_back();
+    EXPECT_THROW(objects.emplace_back(), std::runtime_error);
+    EXPECT_EQ(objects.size(), 3);
+    EXPECT_EQ(std::distance(objects.begin(), objects.end()), 3);
+    ObjectWithExceptions::cnt = 0;
+}
+
+TEST(ring_deque, both_ends_wrap_and_grow) {
+    static_assert(std::random_access_iterator<exp::ring_deque<int>::iterator>);
+    static_assert(std::random_access_iterator<exp::ring_deque<int>::const_iterator>);
+
+    exp::ring_deque<int> deque;
+    std::deque<int> expected;
+    exp::xoshiro256 engine(5);
+    for(int i = 0; i < 5000; ++i) {
+        switch(exp::uniform_int(engine, 0, 5)) {
+        case 0: case 1: deque.push_back(i); expected.push_back(i); break;
+        case 2: case 3: deque.push_front(i); expected.push_front(i); break;
+        case 4: if(!expected.empty()) { deque.pop_back(); expected.pop_back(); } break;
+        default: if(!expected.empty()) { deque.pop_front(); expected.pop_front(); } break;
+        }
+        ASSERT_EQ(deque.size(), expected.size());
+    }
+    EXPECT_TRUE(std::equal(deque.begin(), deque.end(), expected.begin(), expected.end()));
+    EXPECT_TRUE(std::equal(deque.rbegin(), deque.rend(), expected.rbegin(), expected.rend()));
+    EXPECT_EQ(deque.capacity() & (deque.capacity() - 1), 0u);
+
+    std::sort(deque.begin(), deque.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_TRUE(std::equal(deque.begin(), deque.end(), expected.begin(), expected.end()));
+    const auto it = deque.cbegin() + static_cast<std::ptrdiff_t>(deque.size() / 2);
+    EXPECT_EQ(it - deque.cbegin(), static_cast<std::ptrdiff_t>(deque.size() / 2));
+    EXPECT_EQ(it[1], deque[deque.size() / 2 + 1]);
+    EXPECT_TRUE(deque.cbegin() < it);
+}
+
+TEST(ring_deque, bulk_spans_across_the_wrap) {
+    exp::ring_deque<std::uint32_t> deque;
+    deque.reserve(16);
+    std::vector<std::uint32_t> in(12);
+    std::iota(in.begin(), in.end(), 0u);
+    deque.push_back_n(in);
+
+    std::vector<std::uint32_t> out(10);
+    EXPECT_EQ(deque.pop_front_n(out), 10u);
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), in.begin()));
+
+    // Head at slot 10, twelve more wrap past the end of the 16 slot buffer.
+    std::iota(in.begin(), in.end(), 100u);
+    deque.push_back_n(in);
+    EXPECT_EQ(deque.capacity(), 16u);
+    EXPECT_EQ(deque.size(), 14u);
+    out.resize(20);
+    EXPECT_EQ(deque.pop_front_n(out), 14u);
+    EXPECT_EQ(out[0], 10u);
+    EXPECT_EQ(out[1], 11u);
+    EXPECT_TRUE(std::equal(in.begin(), in.end(), out.begin() + 2));
+    EXPECT_TRUE(deque.empty());
+
+    deque.push_back_n(in);
+    EXPECT_EQ(deque.pop_front_n(5), 5u);
+    EXPECT_EQ(deque.front(), 105u);
+    EXPECT_EQ(deque.pop_front_n(100), 7u);
+}
+
+struct ThrowingMoveObject {
+    explicit ThrowingMoveObject(int val = 0): val_(val) { ++live; }
+    ThrowingMoveObject(const ThrowingMoveObject& other): val_(other.val_) { ++live; }
+    ThrowingMoveObject& operator=(ThrowingMoveObject&& other) {
+        if(moves_left-- == 0) {
+            throw std::runtime_error("ThrowingMoveObject: move failed");
+        }
+        val_ = other.val_;
+        return *this;
+    }
+    ~ThrowingMoveObject() { --live; }
+    int val_;
+    inline static int live = 0;
+    inline static int moves_left = 0;
+};
+
+TEST(ring_deque, pop_front_n_throwing_in_second_span) {
+    {
+        exp::ring_deque<ThrowingMoveObject> deque;
+        deque.reserve(4);
+        const std::size_t capacity = deque.capacity();
+        for(std::size_t i = 0; i < capacity; ++i) {
+            deque.push_back(ThrowingMoveObject(static_cast<int>(i)));
+        }
+        deque.pop_front_n(capacity - 2);
+        deque.push_back(ThrowingMoveObject(100));
+        deque.push_back(ThrowingMoveObject(101));
+        ASSERT_EQ(deque.size(), 4u);
+
+        // Two elements before the end of the buffer, the third move throws.
+        std::vector<ThrowingMoveObject> out(4);
+        ThrowingMoveObject::moves_left = 2;
+        EXPECT_THROW(deque.pop_front_n(out), std::runtime_error);
+        EXPECT_EQ(deque.size(), 2u);
+        EXPECT_EQ(deque.front().val_, 100);
+        EXPECT_EQ(ThrowingMoveObject::live, 6);
+    }
+    EXPECT_EQ(ThrowingMoveObject::live, 0);
+}
+
+TEST(ring_deque, non_trivial_elements) {
+    exp::ring_deque<std::string> deque = {"b", "c"};
+    deque.push_front("a");
+    while(deque.size() < deque.capacity()) {
+        deque.push_back(std::string(32, 'q'));
+    }
+    // Growth builds the new element before the old ones move away.
+    deque.push_back(deque.front());
+    EXPECT_EQ(deque.back(), "a");
+    deque.emplace_front(deque[1]);
+    EXPECT_EQ(deque.front(), "b");
+    while(deque.size() > 4) {
+        deque.pop_back();
+    }
+    EXPECT_EQ(deque, exp::ring_deque<std::string>({"b", "a", "b", "c"}));
+
+    std::vector<std::string> words = {"x", "y", "z"};
+    deque.push_back_n(words);
+    std::vector<std::string> out(4);
+    EXPECT_EQ(deque.pop_front_n(out), 4u);
+    EXPECT_EQ(deque, exp::ring_deque<std::string>({"x", "y", "z"}));
+
+    auto copy = deque;
+    auto moved = std::move(deque);
+    EXPECT_EQ(moved, copy);
+    EXPECT_TRUE(deque.empty());
+
+    exp::ring_deque<ObjectWithExceptions> objects;
+    objects.emplace_back();
+    objects.emplace_back();
+    objects.emplace_back();
+    EXPECT_THROW(objects.emplace_front(), std::runtime_error);
+    EXPECT_EQ(objects.size(), 3);
+    ObjectWithExceptions::cnt = 0;
+}
+
+TEST(concurrent_queue, fifo) {
+    exp::concurrent_queue<std::string> queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop());
+
+    queue.push("a");
+    queue.push("b");
+    queue.emplace(3, 'c');
+
+    EXPECT_EQ(queue.try_pop(), "a");
+    EXPECT_EQ(queue.try_pop(), "b");
+    EXPECT_EQ(queue.try_pop(), "ccc");
+    EXPECT_FALSE(queue.try_pop());
+}
+
+TEST(concurrent_queue, multi_producer_multi_consumer) {
+    constexpr int producers = 4;
+    constexpr int items = 10000;
+    exp::concurrent_queue<int> queue;
+    std::atomic<int> consumed{0};
+    std::atomic<long long> sum{0};
+
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            for(int i = 1; i <= items; ++i) {
+                queue.push(i);
+            }
+        });
+        threads.emplace_back([&]() {
+            while(consumed.load() < producers * items) {
+                // empty() reads the head other consumers are retiring.
+                if(queue.empty()) {
+                    continue;
+                }
+                if(auto val = queue.try_pop()) {
+                    sum += *val;
+                    ++consumed;
+                }
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(sum.load(), producers * (items * (items + 1LL) / 2));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(lock_free_list, push_pop_front) {
+    exp::lock_free_list<int> list;
+    list.push_front(1);
+    list.push_front(2);
+
+    EXPECT_EQ(list.try_pop_front(), 2);
+    EXPECT_EQ(list.try_pop_front(), 1);
+    EXPECT_FALSE(list.try_pop_front());
+    EXPECT_TRUE(list.empty());
+}
+
+TEST(lock_free_list, concurrent_push_pop) {
+    constexpr int threads_count = 4;
+    constexpr int items = 10000;
+    exp::lock_free_list<int> list;
+    std::vector<std::vector<int>> popped(threads_count);
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < threads_count; ++t) {
+        threads.emplace_back([&, t]() {
+            for(int i = 0; i < items; ++i) {
+                list.push_front(t * items + i);
+                if(auto val = list.try_pop_front()) {
+                    popped[t].push_back(*val);
+                }
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    while(auto val = list.try_pop_front()) {
+        popped[0].push_back(*val);
+    }
+
+    std::vector<int> all;
+    for(auto& part : popped) {
+        all.insert(all.end(), part.begin(), part.end());
+    }
+    std::sort(all.begin(), all.end());
+    std::vector<int> expected(threads_count * items);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(all, expected);
+}
+
+TEST(concurrent_hash_map, insert_find_erase_across_growth) {
+    exp::concurrent_hash_map<int, std::string> map(4);
+    constexpr int count = 2000;
+    bool saw_rehash = false;
+    for(int i = 0; i < count; ++i) {
+        EXPECT_TRUE(map.insert(i, std::to_string(i)));
+        saw_rehash = saw_rehash || map.rehashing();
+    }
+    EXPECT_TRUE(saw_rehash);
+    EXPECT_FALSE(map.insert(7, "dup"));
+    EXPECT_EQ(map.size(), static_cast<size_t>(count));
+    EXPECT_GE(map.bucket_count(), static_cast<size_t>(count) / 2);
+
+    // Lookups see entries whether or not their old bucket has been drained yet.
+    for(int i = 0; i < count; ++i) {
+        ASSERT_EQ(map.find(i), std::to_string(i));
+    }
+    EXPECT_FALSE(map.find(count));
+
+    EXPECT_FALSE(map.insert_or_assign(7, std::string("seven")));
+    EXPECT_TRUE(map.insert_or_assign(count, std::string("new")));
+    EXPECT_TRUE(map.update(7, [](std::string& val) { val += "!"; }));
+    EXPECT_EQ(map.find(7), "seven!");
+
+    for(int i = 0; i < count; i += 2) {
+        EXPECT_TRUE(map.erase(i));
+    }
+    EXPECT_FALSE(map.erase(0));
+    EXPECT_EQ(map.size(), static_cast<size_t>(count / 2 + 1));
+
+    long long sum = 0;
+    map.for_each([&sum](const auto& entry) { sum += entry.first; });
+    EXPECT_EQ(sum, count * count / 4LL + count);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(1));
+}
+
+TEST(concurrent_hash_map, concurrent_writers_and_readers) {
+    constexpr int writers = 4;
+    constexpr int items = 5000;
+    exp::concurrent_hash_map<int, int> map(8);
+    std::atomic<bool> done{false};
+    std::atomic<int> bad_reads{0};
+
+    std::vector<std::thread> threads;
+    for(int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w]() {
+            for(int i = 0; i < items; ++i) {
+                const int key = w * items + i;
+                map.insert(key, key * 2);
+                if(i % 3 == 0) {
+                    map.erase(key);
+                }
+            }
+        });
+    }
+    std::thread reader([&]() {
+        while(!done.load()) {
+            for(int key = 0; key < writers * items; key += 97) {
+                map.visit(key, [&](int val) {
+                    if(val != key * 2) {
+                        ++bad_reads;
+                    }
+                });
+            }
+        }
+    });
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(bad_reads.load(), 0);
+    EXPECT_EQ(map.size(), static_cast<size_t>(writers * (items - (items + 2) / 3)));
+    for(int key = 0; key < writers * items; ++key) {
+        ASSERT_EQ(map.contains(key), key % items % 3 != 0);
+    }
+}
+
+TEST(hazard_pointers, protected_node_survives_retire) {
+    static int deleted = 0;
+    struct Tracked {
+        ~Tracked() { ++deleted; }
+    };
+
+    deleted = 0;
+    std::atomic<Tracked*> shared{new Tracked};
+    {
+        exp::hazard_guard guard;
+        Tracked* ptr = guard.protect(shared);
+        std::thread([&]() {
+            Tracked* old = shared.exchange(nullptr);
+            exp::retire(old);
+            for(size_t i = 0; i < exp::hazard_pointer_domain::scan_threshold; ++i) {
+                exp::retire(new Tracked);
+            }
+        }).join();
+        EXPECT_EQ(deleted, static_cast<int>(exp::hazard_pointer_domain::scan_threshold));
+        EXPECT_NE(ptr, nullptr);
+    }
+    std::vector<exp::hazard_pointer_domain::Retired> none;
+    exp::hazard_pointer_domain::global().scan(none);
+    EXPECT_EQ(deleted, static_cast<int>(exp::hazard_pointer_domain::scan_threshold) + 1);
+}
+
+TEST(parallel_reduce, matches_accumulate) {
+    exp::chunked_thread_pool pool(4);
+    std::vector<long long> vec(1'000'003);
+    std::iota(vec.begin(), vec.end(), 0);
+
+    EXPECT_EQ(exp::parallel_reduce(pool, vec.begin(), vec.end(), 10LL), std::accumulate(vec.begin(), vec.end(), 10LL));
+    EXPECT_EQ(exp::parallel_reduce(pool, vec.begin(), vec.begin() + 5, 0LL), 10);
+}
+
+TEST(parallel_reduce, transform_reduce) {
+    exp::chunked_thread_pool pool(3);
+    std::vector<int> vec(300'000, 2);
+
+    auto res = exp::parallel_transform_reduce(pool, vec.begin(), vec.end(), 0.0, std::plus<>{}, [](int val) { return val * 0.5; });
+    EXPECT_DOUBLE_EQ(res, 300'000.0);
+}
+
+TEST(parallel_reduce, rethrows_chunk_exception) {
+    exp::chunked_thread_pool pool(4);
+    EXPECT_THROW(pool.run(16, [](size_t chunk) {
+        if(chunk == 7) {
+            throw std::runtime_error("chunk failed");
+        }
+    }), std::runtime_error);
+
+    std::atomic<size_t> done{0};
+    pool.run(16, [&done](size_t) { ++done; });
+    EXPECT_EQ(done.load(), 16);
+}
+
+TEST(parallel_generate, independent_of_thread_count) {
+    auto gen = [](exp::xoshiro256& engine) { return exp::uniform_int(engine, 1, 100); };
+    std::vector<int> one(200'000);
+    std::vector<int> many(200'000);
+
+    exp::chunked_thread_pool single(1);
+    exp::chunked_thread_pool pool(4);
+    exp::parallel_generate(single, one.begin(), one.end(), 7, gen);
+    exp::parallel_generate(pool, many.begin(), many.end(), 7, gen);
+
+    EXPECT_EQ(one, many);
+    EXPECT_EQ(*std::min_element(one.begin(), one.end()), 1);
+    EXPECT_EQ(*std::max_element(one.begin(), one.end()), 100);
+}
+
+TEST(chase_lev_deque, owner_lifo_thief_fifo) {
+    exp::chase_lev_deque<int> deque(2);
+    int values[5] = {0,1,2,3,4};
+    for(auto& val : values) {
+        deque.push(&val);
+    }
+
+    EXPECT_EQ(deque.steal(), &values[0]);
+    EXPECT_EQ(deque.pop(), &values[4]);
+    EXPECT_EQ(deque.pop(), &values[3]);
+    EXPECT_EQ(deque.steal(), &values[1]);
+    EXPECT_EQ(deque.pop(), &values[2]);
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(work_stealing_pool, submit) {
+    exp::work_stealing_pool pool(4);
+    auto sum = pool.submit([](int a, int b) { return a + b; }, 2, 3);
+    auto text = pool.submit([]() { return std::string("done"); });
+
+    EXPECT_EQ(sum.get(), 5);
+    EXPECT_EQ(text.get(), "done");
+}
+
+TEST(work_stealing_pool, submit_propagates_exception) {
+    exp::work_stealing_pool pool(2);
+    auto result = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(work_stealing_pool, parallel_for_index) {
+    exp::work_stealing_pool pool(4);
+    std::vector<int> vec(100'000);
+    pool.parallel_for(size_t{0}, vec.size(), [&vec](size_t idx) { vec[idx] = static_cast<int>(idx); });
+
+    std::vector<int> expected(100'000);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(vec, expected);
+}
+
+TEST(work_stealing_pool, parallel_for_list) {
+    exp::work_stealing_pool pool(3);
+    exp::list<int> list;
+    for(int i = 0; i < 1000; ++i) {
+        list.push_back(i);
+    }
+    pool.parallel_for(list.begin(), list.end(), [](int& val) { val *= 2; });
+
+    int expected = 0;
+    for(int val : list) {
+        EXPECT_EQ(val, expected);
+        expected += 2;
+    }
+}
+
+TEST(work_stealing_pool, nested_parallel_for) {
+    exp::work_stealing_pool pool(4);
+    std::atomic<int> count{0};
+    pool.parallel_for(0, 16, [&](int) {
+        pool.parallel_for(0, 100, [&](int) { ++count; });
+    });
+    EXPECT_EQ(count.load(), 1600);
+}
+
+TEST(work_stealing_pool, parallel_for_rethrows) {
+    exp::work_stealing_pool pool(4);
+    EXPECT_THROW(pool.parallel_for(0, 1000, [](int idx) {
+        if(idx == 500) {
+            throw std::runtime_error("index failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST(work_stealing_pool, parallel_for_runs_inline_when_spawn_fails) {
+    exp::work_stealing_pool pool(2);
+    pool.shutdown();
+    std::vector<int> vec(1000);
+    pool.parallel_for(size_t{0}, vec.size(), [&vec](size_t idx) { vec[idx] = static_cast<int>(idx); }, size_t{10});
+    for(size_t i = 0; i < vec.size(); ++i) {
+        ASSERT_EQ(vec[i], static_cast<int>(i));
+    }
+}
+
+TEST(parallel_algorithms, list_and_zip_range) {
+    exp::work_stealing_pool pool(4);
+    exp::list<int> list;
+    for(int i = 0; i < 100000; ++i) {
+        list.push_back(i);
+    }
+
+    exp::parallel::for_each(pool, list, [](int& val) { val *= 2; });
+    EXPECT_EQ(*std::prev(list.end()), 199998);
+    EXPECT_EQ(exp::parallel::reduce(pool, list, 0LL), 99999LL * 100000);
+    EXPECT_EQ(exp::parallel::count_if(pool, list, [](int val) { return val % 3 == 0; }), 33334);
+
+    auto found = exp::parallel::find_if(pool, list, [](int val) { return val > 150000; });
+    ASSERT_NE(found, list.end());
+    EXPECT_EQ(*found, 150002);
+    EXPECT_EQ(exp::parallel::find_if(pool, list, [](int val) { return val < 0; }), list.end());
+
+    std::vector<long long> squares(list.size());
+    exp::parallel::transform(pool, list, squares, [](int val) { return static_cast<long long>(val) * val; });
+    EXPECT_EQ(squares[1000], 2000LL * 2000);
+
+    std::vector<double> weights(squares.size(), 0.5);
+    auto zip = make_zip_range(squares, weights);
+    auto total = exp::parallel::reduce(pool, zip | exp::views::transform([](auto row) { return std::get<0>(row) * std::get<1>(row); }), 0.0);
+    EXPECT_DOUBLE_EQ(total, std::accumulate(squares.begin(), squares.end(), 0.0) * 0.5);
+
+    auto first_big = exp::parallel::find_if(pool, zip, [](auto row) { return std::get<0>(row) > 1'000'000; });
+    EXPECT_EQ(first_big - zip.begin(), 501);
+
+    exp::list<int> empty;
+    EXPECT_EQ(exp::parallel::reduce(pool, empty, 7), 7);
+    EXPECT_EQ(exp::parallel::find_if(pool, empty, [](int) { return true; }), empty.end());
+}
+
+TEST(parallel_algorithms, rethrows) {
+    exp::work_stealing_pool pool(4);
+    std::vector<int> vec(50000, 1);
+    EXPECT_THROW(exp::parallel::for_each(pool, vec, [](int val) {
+        if(val == 1) {
+            throw std::runtime_error("bad element");
+        }
+    }), std::runtime_error);
+}
+
+TEST(work_stealing_pool, shutdown_runs_queued_tasks) {
+    std::atomic<int> done{0};
+    {
+        exp::work_stealing_pool pool(2);
+        for(int i = 0; i < 100; ++i) {
+            pool.submit([&done]() { ++done; });
+        }
+        pool.shutdown();
+        EXPECT_THROW(pool.submit([]() {}), std::runtime_error);
+    }
+    EXPECT_EQ(done.load(), 100);
+}
+
+TEST(work_stealing_pool, submit_racing_shutdown_runs_or_throws) {
+    for(int round = 0; round < 50; ++round) {
+        std::vector<std::future<void>> futures;
+        exp::work_stealing_pool pool(2);
+        std::thread submitter([&pool, &futures]() {
+            try {
+                for(;;) {
+                    futures.push_back(pool.submit([]() {}));
+                }
+            } catch(const std::runtime_error&) {
+            }
+        });
+        std::this_thread::yield();
+        pool.shutdown();
+        submitter.join();
+        for(auto& future : futures) {
+            ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        }
+    }
+}
+
+TEST(latency_histogram, quantiles) {
+    exp::instrumentation::latency_histogram histogram;
+    for(std::uint64_t value = 1; value <= 100'000; ++value) {
+        histogram.record(value);
+    }
+
+    EXPECT_EQ(histogram.count(), 100'000);
+    EXPECT_EQ(histogram.max(), 100'000);
+    auto near = [](std::uint64_t actual, double expected) {
+        return actual >= expected && actual <= expected * (1 + 1.0 / 64);
+    };
+    EXPECT_TRUE(near(histogram.quantile(0.5), 50'000));
+    EXPECT_TRUE(near(histogram.quantile(0.99), 99'000));
+    EXPECT_TRUE(near(histogram.quantile(0.999), 99'900));
+    EXPECT_EQ(histogram.quantile(1.0), 100'000);
+
+    exp::instrumentation::latency_histogram small;
+    small.record(3);
+    small.record(7);
+    EXPECT_EQ(small.quantile(0.5), 3);
+    histogram.merge(small);
+    EXPECT_EQ(histogram.count(), 100'002);
+}
+
+TEST(latency_histogram, bucket_bounds) {
+    using hist = exp::instrumentation::latency_histogram;
+    for(std::uint64_t value : {0ull, 127ull, 128ull, 1000ull, 123'456'789ull, ~0ull}) {
+        const auto idx = hist::bucketOf(value);
+        EXPECT_LT(idx, hist::bucket_count);
+        EXPECT_GE(hist::bucketUpperBound(idx), value);
+        if(idx > 0) {
+            EXPECT_LT(hist::bucketUpperBound(idx - 1), value);
+        }
+    }
+}
+
+TEST(event_ring, drops_when_full) {
+    exp::instrumentation::event_ring ring(4);
+    for(std::uint64_t i = 0; i < 6; ++i) {
+        ring.try_push({"event", i, 1});
+    }
+    EXPECT_EQ(ring.dropped(), 2);
+
+    std::vector<std::uint64_t> starts;
+    EXPECT_EQ(ring.drain([&starts](const auto& event) { starts.push_back(event.start_); }), 4);
+    EXPECT_EQ(starts, std::vector<std::uint64_t>({0,1,2,3}));
+    EXPECT_TRUE(ring.try_push({"event", 9, 1}));
+}
+
+TEST(scoped_timer, first_scope_starts_after_origin) {
+    using namespace exp::instrumentation;
+    std::vector<collected_event> events;
+    trace_registry::global().drain(events);
+    events.clear();
+
+    std::thread([] { scoped_timer timer("first"); }).join();
+
+    trace_registry::global().drain(events);
+    std::erase_if(events, [](const collected_event& event) { return std::string_view(event.event_.name_) != "first"; });
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_GE(events[0].event_.start_, tsc_clock::origin());
+    EXPECT_LT(tsc_clock::to_ns(events[0].event_.duration_), 5'000'000);
+}
+
+TEST(scoped_timer, records_event_and_exports_trace) {
+    using namespace exp::instrumentation;
+    std::vector<collected_event> events;
+    trace_registry::global().drain(events);
+    events.clear();
+
+    latency_histogram histogram;
+    {
+        scoped_timer timer("list \"push\"", &histogram);
+        exp::list<int> list;
+        list.emplace_back_n(1000, 1);
+    }
+    std::thread([] { scoped_timer timer("worker"); }).join();
+
+    trace_registry::global().drain(events);
+    // Scopes inside exp::list are recorded too when EXP_INSTRUMENTATION is on.
+    std::erase_if(events, [](const collected_event& event) { return std::string_view(event.event_.name_).starts_with("exp::"); });
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(histogram.count(), 1);
+    EXPECT_NE(events[0].thread_id_, events[1].thread_id_);
+
+    std::ostringstream os;
+    write_chrome_trace(os, events);
+    const auto json = os.str();
+    EXPECT_NE(json.find("\"name\":\"list \\\"push\\\"\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"worker\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+}
+
+TEST(scoped_timer, exited_threads_rings_are_reused) {
+    using namespace exp::instrumentation;
+    std::vector<collected_event> events;
+    std::thread([] { scoped_timer timer("warm up"); }).join();
+    trace_registry::global().drain(events);
+    const std::size_t rings = trace_registry::global().ring_count();
+
+    for(int i = 0; i < 8; ++i) {
+        std::thread([] { scoped_timer timer("churn"); }).join();
+        trace_registry::global().drain(events);
+    }
+    EXPECT_EQ(trace_registry::global().ring_count(), rings);
+
+    // Every thread keeps its own id even when it reuses a ring.
+    std::erase_if(events, [](const collected_event& event) { return std::string_view(event.event_.name_) != "churn"; });
+    ASSERT_EQ(events.size(), 8);
+    for(std::size_t i = 1; i < events.size(); ++i) {
+        EXPECT_NE(events[i].thread_id_, events[i - 1].thread_id_);
+    }
+}
+
+TEST(scoped_timer, macros_compile_out) {
+    int evaluated = 0;
+    auto histogram = [&evaluated]() -> exp::instrumentation::latency_histogram& {
+        static exp::instrumentation::latency_histogram hist;
+        ++evaluated;
+        return hist;
+    };
+    EXP_TRACE_SCOPE("scope");
+    EXP_TRACE_SCOPE_HIST("scope", histogram());
+#if defined(EXP_INSTRUMENTATION)
+    EXPECT_EQ(evaluated, 1);
+#else
+    EXPECT_EQ(evaluated, 0);
+    static_cast<void>(histogram);
+#endif
+}
+
+TEST(skip_list, ordered_insert_find_erase) {
+    exp::skip_list<int, std::string> index;
+    exp::xoshiro256 engine(3);
+    std::vector<int> keys;
+    for(int i = 0; i < 5000; ++i) {
+        const int key = exp::uniform_int(engine, 0, 100000);
+        keys.push_back(key);
+        index.emplace(key, std::to_string(key));
+    }
+    std::sort(keys.begin(), keys.end());
+
+    EXPECT_EQ(index.size(), keys.size());
+    std::vector<int> scanned;
+    for(const auto& [key, value] : index) {
+        EXPECT_EQ(value, std::to_string(key));
+        scanned.push_back(key);
+    }
+    EXPECT_EQ(scanned, keys);
+
+    for(int probe : {keys.front(), keys[2500], keys.back(), -1, 100001}) {
+        auto it = index.lower_bound(probe);
+        auto expected = std::lower_bound(keys.begin(), keys.end(), probe);
+        if(expected == keys.end()) {
+            EXPECT_EQ(it, index.end());
+        } else {
+            EXPECT_EQ(it->first, *expected);
+        }
+        EXPECT_EQ(index.contains(probe), std::binary_search(keys.begin(), keys.end(), probe));
+    }
+
+    for(std::size_t i = 0; i < keys.size(); i += 2) {
+        index.erase(index.find(keys[i]));
+    }
+    EXPECT_EQ(index.size(), keys.size() / 2);
+    std::vector<int> rest;
+    for(std::size_t i = 1; i < keys.size(); i += 2) {
+        rest.push_back(keys[i]);
+    }
+    scanned.clear();
+    for(auto it = index.begin(); it != index.end(); ++it) {
+        scanned.push_back(it->first);
+    }
+    EXPECT_EQ(scanned, rest);
+    EXPECT_EQ(std::prev(index.end())->first, rest.back());
+}
+
+TEST(skip_list, equal_keys_keep_insertion_order) {
+    exp::skip_list<std::uint64_t, int> events;
+    for(int i = 0; i < 100; ++i) {
+        events.emplace(static_cast<std::uint64_t>(i / 10), i);
+    }
+    events.emplace(std::uint64_t{5}, 1000);
+
+    EXPECT_EQ(events.count(5), 11);
+    auto [first, last] = events.equal_range(5);
+    std::vector<int> payloads;
+    for(; first != last; ++first) {
+        payloads.push_back(first->second);
+    }
+    EXPECT_EQ(payloads, (std::vector<int>{50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 1000}));
+
+    EXPECT_EQ(events.erase(5), 11);
+    EXPECT_FALSE(events.contains(5));
+    EXPECT_EQ(events.upper_bound(4)->first, 6);
+
+    events.erase(events.lower_bound(9), events.end());
+    events.emplace(std::uint64_t{20}, -1);
+    EXPECT_EQ(std::prev(events.end())->second, -1);
+    EXPECT_EQ(events.size(), 81);
+}
+
+TEST(skip_list, copy_move_clear) {
+    exp::skip_list<int, int> index = {{3, 30}, {1, 10}, {2, 20}};
+    auto copy = index;
+    EXPECT_EQ(copy.begin()->second, 10);
+
+    auto moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_EQ(moved.find(3)->second, 30);
+
+    copy.emplace(7, 70);
+    moved.swap(copy);
+    EXPECT_EQ(moved.size(), 1);
+    EXPECT_EQ(copy.size(), 3);
+
+    copy.clear();
+    EXPECT_EQ(copy.begin(), copy.end());
+    copy.emplace(4, 40);
+    EXPECT_EQ(copy.find(4)->second, 40);
+}
+
+struct sample_event {
+    std::uint64_t ts_;
+    std::int32_t id_;
+    float value_;
+};
+
+TEST(lru_cache, evicts_least_recently_used) {
+    exp::lru_cache<int, std::string> cache(3);
+    EXPECT_TRUE(cache.put(1, "one"));
+    EXPECT_TRUE(cache.put(2, "two"));
+    EXPECT_TRUE(cache.put(3, "three"));
+    ASSERT_NE(cache.get(1), nullptr);
+    EXPECT_EQ(*cache.get(1), "one");
+    EXPECT_TRUE(cache.put(4, "four"));
+
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_EQ(cache.get(2), nullptr);
+    EXPECT_EQ(cache.size(), 3u);
+    std::vector<int> order;
+    cache.for_each([&order](int key, const std::string&) { order.push_back(key); });
+    EXPECT_EQ(order, (std::vector<int>{4, 1, 3}));
+
+    // Replacing a value refreshes it, peek leaves the order alone.
+    EXPECT_TRUE(cache.put(3, "drei"));
+    EXPECT_EQ(*cache.peek(1), "one");
+    EXPECT_TRUE(cache.put(5, "five"));
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(*cache.peek(3), "drei");
+
+    EXPECT_EQ(cache.stats().hits_, 2u);
+    EXPECT_EQ(cache.stats().misses_, 1u);
+    EXPECT_EQ(cache.stats().evictions_, 2u);
+
+    EXPECT_TRUE(cache.erase(3));
+    EXPECT_FALSE(cache.erase(3));
+    cache.set_capacity(1);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_TRUE(cache.contains(5));
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.weight(), 0u);
+}
+
+TEST(lru_cache, hits_and_evictions_reuse_nodes) {
+    using alloc = exp::stats_allocator<int>;
+    auto& stats = exp::allocation_registry::global().get("test.lru_cache");
+    exp::lru_cache<int, int, exp::unit_weight, std::hash<int>, std::equal_to<int>, alloc> cache(64, {}, {}, {}, alloc(stats));
+    for(int key = 0; key < 64; ++key) {
+        cache.put(key, key);
+    }
+    const auto before = stats.snapshot();
+
+    exp::xoshiro256 engine(3);
+    for(int round = 0; round < 10000; ++round) {
+        const int key = exp::uniform_int(engine, 0, 127);
+        if(int* val = cache.get(key)) {
+            ASSERT_EQ(*val, key);
+        } else {
+            cache.put(key, key);
+        }
+    }
+    EXPECT_EQ(stats.snapshot().allocations_, before.allocations_);
+    EXPECT_EQ(cache.size(), 64u);
+    EXPECT_EQ(cache.stats().hits_ + cache.stats().misses_, 10000u);
+    EXPECT_EQ(cache.stats().evictions_, cache.stats().misses_);
+    for(int key = 0; key < 128; ++key) {
+        if(const int* val = cache.peek(key)) {
+            EXPECT_EQ(*val, key);
+        }
+    }
+}
+
+TEST(lru_cache, capacity_in_bytes) {
+    auto bytes = [](int, const std::string& val) { return val.size(); };
+    exp::lru_cache<int, std::string, decltype(bytes)> cache(10, bytes);
+    cache.put(1, std::string(4, 'a'));
+    cache.put(2, std::string(4, 'b'));
+    EXPECT_EQ(cache.weight(), 8u);
 
-// TEST(list, it_ctor) {
-//     std::vector vec {1,2,3,4};
+    cache.put(3, std::string(7, 'c'));
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_EQ(cache.weight(), 7u);
+    EXPECT_EQ(cache.stats().evictions_, 2u);
 
-//     exp::list list(vec.begin(), vec.end());
+    // Too heavy to keep: not stored, and the old value of the key is dropped.
+    EXPECT_FALSE(cache.put(3, std::string(11, 'd')));
+    EXPECT_FALSE(cache.contains(3));
+    EXPECT_TRUE(cache.empty());
 
-//     exp::list list1 {1,2,3,4};
-//     EXPECT_EQ(list, list1);
-// }
+    cache.put(4, std::string(3, 'e'));
+    cache.put(4, std::string(9, 'f'));
+    EXPECT_EQ(cache.weight(), 9u);
+}
+
+TEST(mapped_list, round_trip_in_place) {
+    const auto path = std::filesystem::temp_directory_path() / "exp_mapped_list_test.bin";
+    exp::list<sample_event> events;
+    for(int i = 0; i < 10000; ++i) {
+        events.push_back({static_cast<std::uint64_t>(i) * 10, i, i * 0.5f});
+    }
+    exp::write_mapped_list(events, path);
+
+    exp::mapped_list<sample_event> mapped(path);
+    ASSERT_EQ(mapped.size(), events.size());
+    auto it = events.begin();
+    for(const auto& event : mapped) {
+        EXPECT_EQ(event.ts_, it->ts_);
+        EXPECT_EQ(event.id_, it->id_);
+        ++it;
+    }
+    EXPECT_EQ(mapped.back().id_, 9999);
+    EXPECT_EQ(std::prev(mapped.end(), 2)->ts_, 99980);
+
+    exp::list<sample_event> reloaded(mapped.begin(), mapped.end());
+    EXPECT_EQ(reloaded.size(), events.size());
+
+    auto moved = std::move(mapped);
+    EXPECT_EQ(moved.front().value_, 0.0f);
+
+    exp::write_mapped_list(exp::list<sample_event>{}, path);
+    exp::mapped_list<sample_event> empty(path);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.begin(), empty.end());
+    std::filesystem::remove(path);
+}
+
+TEST(mapped_list, rejects_foreign_files) {
+    const auto path = std::filesystem::temp_directory_path() / "exp_mapped_list_bad.bin";
+    exp::write_mapped_list(std::vector<std::int32_t>{1, 2, 3}, path);
+    EXPECT_EQ(exp::mapped_list<std::int32_t>(path).size(), 3);
+    EXPECT_THROW(exp::mapped_list<std::int64_t>{path}, std::runtime_error);
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+    EXPECT_THROW(exp::mapped_list<std::int32_t>{path}, std::runtime_error);
+
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "definitely not a list file, but long enough for a header";
+    }
+    EXPECT_THROW(exp::mapped_list<std::int32_t>{path}, std::runtime_error);
+    std::filesystem::remove(path);
+    EXPECT_THROW(exp::mapped_list<std::int32_t>{path}, std::runtime_error);
+}
 
-// TEST(list, copy_ctor) {
-//     exp::list list {1,2,3,4};
+TEST(mapped_list, failed_write_keeps_old_file_and_removes_temporary) {
+    const auto path = std::filesystem::temp_directory_path() / "exp_mapped_list_failed.bin";
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    exp::write_mapped_list(std::vector<std::int32_t>{1, 2, 3}, path);
+
+    const std::vector<std::int32_t> values(10000, 7);
+    auto failing = values | std::views::transform([](std::int32_t val) -> std::int32_t {
+        static int calls = 0;
+        if(++calls == 5000) {
+            throw std::runtime_error("source failed");
+        }
+        return val;
+    });
+    EXPECT_THROW(exp::write_mapped_list(failing, path), std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists(tmp_path));
+    EXPECT_EQ(exp::mapped_list<std::int32_t>(path).size(), 3);
+    std::filesystem::remove(path);
+}
 
-//     auto list1 = list;
+TEST(chunk_stream, reduces_file_in_bounded_chunks) {
+    const auto path = std::filesystem::temp_directory_path() / "exp_chunk_stream_test.bin";
+    std::vector<std::int32_t> values(100003);
+    std::iota(values.begin(), values.end(), -50000);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(std::int32_t)));
+    }
 
-//     EXPECT_EQ(list, list1);
-// }
+    exp::chunk_stream<std::int32_t> stream(path, 4096, 3);
+    exp::running_stats<std::int32_t> stats;
+    std::size_t chunks = 0;
+    std::int32_t expected_next = -50000;
+    bool in_order = true;
+    auto order = [&](std::span<const std::int32_t> chunk) {
+        ++chunks;
+        EXPECT_LE(chunk.size(), 4096);
+        for(std::int32_t value : chunk) {
+            in_order = in_order && value == expected_next++;
+        }
+    };
+    EXPECT_EQ(exp::stream_reduce(stream, stats, order), values.size());
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(chunks, (values.size() + 4095) / 4096);
+    EXPECT_EQ(stats.count(), values.size());
+    EXPECT_EQ(stats.min(), -50000);
+    EXPECT_EQ(stats.max(), 50002);
+    EXPECT_DOUBLE_EQ(stats.mean(), 1.0);
+    EXPECT_TRUE(stream.next().empty());
 
-// TEST(list, move_ctor) {
-//     exp::list list {1,2,3,4};
-//     exp::list ref_list {1,2,3,4};
+    // Abandoned half way: the reader must stop without waiting for a consumer.
+    {
+        exp::chunk_stream<std::int32_t> partial(path, 1024, 2);
+        EXPECT_EQ(partial.next().size(), 1024);
+    }
 
-//     auto list1 = std::move(list);
+    std::filesystem::resize_file(path, values.size() * sizeof(std::int32_t) - 2);
+    exp::chunk_stream<std::int32_t> truncated(path, 4096, 2);
+    std::size_t seen = 0;
+    EXPECT_THROW({
+        for(auto chunk = truncated.next(); !chunk.empty(); chunk = truncated.next()) {
+            seen += chunk.size();
+        }
+    }, std::runtime_error);
+    EXPECT_EQ(seen, values.size() / 4096 * 4096);
 
-//     EXPECT_EQ(list1, ref_list);
-// }
+    std::filesystem::remove(path);
+    EXPECT_THROW(exp::chunk_stream<std::int32_t>{path}, std::runtime_error);
+}
 
 TEST(zip_iterator, ctor_and_deref) {
     std::vector vec = {1,2,3,4};
@@ -314,7 +2035,6 @@ TEST(zip_range, ctor) {
     int raw_arr[4] = {10,20,30,40};
     std::vector<bool> bvec = {true, false, true, false};
 
-TEST(zip_range, ctor) {
     auto [a,b,c,d] = *make_zip_range(vec, list, raw_arr, bvec).begin();
     EXPECT_EQ(a, 1);
     EXPECT_EQ(b, 5);
@@ -323,6 +2043,11 @@ TEST(zip_range, ctor) {
 }
 
 TEST(zip_range, range_base_loop) {
+    std::vector vec = {1,2,3,4};
+    std::list list = {5,6,7,8};
+    int raw_arr[4] = {10,20,30,40};
+    std::vector<bool> bvec = {true, false, true, false};
+
     std::stringstream ss;
     for(const auto& [a,b,c,d] : make_zip_range(vec, list, raw_arr, bvec)) {
         ss << a << b << c << d;
@@ -330,6 +2055,309 @@ TEST(zip_range, range_base_loop) {
     EXPECT_EQ(ss.str(), "15101262003730148400");
 }
 
+TEST(zip_iterator, random_access_jumps) {
+    std::vector vec = {1,2,3,4,5};
+    std::vector<double> dvec = {1.5,2.5,3.5,4.5,5.5};
+    auto range = make_zip_range(vec, dvec);
+
+    auto it = range.begin();
+    it += 3;
+    EXPECT_EQ(std::get<0>(*it), 4);
+    EXPECT_EQ(range.end() - range.begin(), 5);
+    EXPECT_EQ(std::get<1>(*(it - 2)), 2.5);
+
+    std::get<0>(*it) = 40;
+    EXPECT_EQ(vec[3], 40);
+}
+
+TEST(zip_iterator, sorts_as_random_access) {
+    using vec_zip = zip_iterator<std::vector<int>::iterator, std::vector<std::string>::iterator>;
+    static_assert(std::random_access_iterator<vec_zip>);
+    static_assert(std::sortable<vec_zip>);
+    static_assert(!std::random_access_iterator<zip_iterator<std::vector<int>::iterator, std::list<int>::iterator>>);
+
+    std::vector keys = {5, 3, 9, 1, 7};
+    std::vector<std::string> names = {"five", "three", "nine", "one", "seven"};
+    auto range = make_zip_range(keys, names);
+
+    std::sort(range.begin(), range.end(), [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) < std::get<0>(rhs); });
+    EXPECT_EQ(keys, (std::vector{1, 3, 5, 7, 9}));
+    EXPECT_EQ(names, (std::vector<std::string>{"one", "three", "five", "seven", "nine"}));
+
+    auto found = std::lower_bound(range.begin(), range.end(), 6, [](const auto& row, int key) { return std::get<0>(row) < key; });
+    EXPECT_EQ(found - range.begin(), 3);
+    EXPECT_EQ(std::get<1>(found[1]), "nine");
+    EXPECT_LT(range.begin(), found);
+
+    std::ranges::sort(range.begin(), range.end(), std::greater<>{}, [](const auto& row) { return std::get<1>(row); });
+    EXPECT_EQ(names, (std::vector<std::string>{"three", "seven", "one", "nine", "five"}));
+    EXPECT_EQ(keys, (std::vector{3, 7, 1, 9, 5}));
+
+    exp::soa_vector<int, double> table = {{3, 0.3}, {1, 0.1}, {2, 0.2}};
+    std::sort(table.begin(), table.end());
+    EXPECT_EQ(table.column<0>()[0], 1);
+    EXPECT_EQ(table.column<1>()[2], 0.3);
+}
+
+TEST(soa_vector, push_back_and_columns) {
+    exp::soa_vector<int, double, char> table;
+    for(int i = 0; i < 100; ++i) {
+        table.emplace_back(i, i * 0.5, static_cast<char>('a' + i % 26));
+    }
+
+    EXPECT_EQ(table.size(), 100);
+    EXPECT_GE(table.capacity(), 100);
+    auto ints = table.column<0>();
+    EXPECT_EQ(ints.size(), 100);
+    EXPECT_EQ(std::accumulate(ints.begin(), ints.end(), 0), 4950);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(table.data<1>()) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(table.data<2>()) % 64, 0);
+
+    auto [i, d, c] = table[27];
+    EXPECT_EQ(i, 27);
+    EXPECT_EQ(d, 13.5);
+    EXPECT_EQ(c, 'b');
+}
+
+TEST(soa_vector, rows_through_zip_iterator) {
+    exp::soa_vector<int, double> table = {{1, 1.0}, {2, 2.0}, {3, 3.0}};
+
+    for(auto [i, d] : table) {
+        d += i;
+    }
+    EXPECT_EQ(table.column<1>()[2], 6.0);
+    EXPECT_EQ(table.end() - table.begin(), 3);
+
+    const auto& ctable = table;
+    auto it = ctable.begin() + 1;
+    EXPECT_EQ(std::get<0>(*it), 2);
+
+    auto zip = table.zip();
+    EXPECT_EQ(exp::zip_reduce(zip, 0.0, std::plus<>{}, [](int i, double d) { return i * d; }), 1 * 2.0 + 2 * 4.0 + 3 * 6.0);
+}
+
+TEST(soa_vector, copy_move_resize) {
+    exp::soa_vector<std::string, int> table;
+    table.push_back({"one", 1});
+    table.push_back({"two", 2});
+
+    auto copy = table;
+    EXPECT_EQ(copy, table);
+
+    auto moved = std::move(copy);
+    EXPECT_EQ(moved, table);
+    EXPECT_EQ(copy.size(), 0);
+
+    moved.resize(5);
+    EXPECT_EQ(moved.size(), 5);
+    EXPECT_EQ(std::get<0>(moved[4]), "");
+    moved.pop_back();
+    moved.resize(1);
+    EXPECT_EQ(std::get<0>(moved[0]), "one");
+    moved.shrink_to_fit();
+    EXPECT_EQ(moved.capacity(), 1);
+}
+
+// Throws once three instances are alive.
+struct LimitedObject {
+    LimitedObject() { acquire(); }
+    LimitedObject(const LimitedObject&) { acquire(); }
+    ~LimitedObject() { --live; }
+    static void acquire() {
+        if(live == 3) {
+            throw std::runtime_error("LimitedObject: no more objects");
+        }
+        ++live;
+    }
+    inline static int live = 0;
+};
+
+TEST(soa_vector, throwing_column_constructor_frees_rows) {
+    EXPECT_THROW((exp::soa_vector<std::string, LimitedObject>(5)), std::runtime_error);
+    EXPECT_EQ(LimitedObject::live, 0);
+
+    exp::soa_vector<std::string, LimitedObject> table(2);
+    EXPECT_THROW(auto copy = table, std::runtime_error);
+    EXPECT_EQ(LimitedObject::live, 2);
+}
+
+TEST(zip_kernels, for_each_contiguous_and_generic) {
+    std::vector vec = {1,2,3,4};
+    int raw_arr[4] = {10,20,30,40};
+    auto contiguous = make_zip_range(vec, raw_arr);
+    static_assert(decltype(contiguous)::is_contiguous);
+
+    exp::zip_for_each(contiguous, [](int& a, int b) { a += b; });
+    EXPECT_EQ(vec, std::vector({11,22,33,44}));
+
+    std::list list = {5,6,7,8};
+    auto generic = make_zip_range(vec, list);
+    static_assert(!decltype(generic)::is_contiguous);
+    exp::zip_for_each(generic, [](int a, int& b) { b = a - b; });
+    EXPECT_EQ(list, std::list({6,16,26,36}));
+}
+
+TEST(zip_kernels, transform_matches_scalar) {
+    // 37 rows leave a tail after every vector width
+    std::vector<float> a(37), b(37), c(37), out(37);
+    std::vector<std::int32_t> ia(37), ib(37), iout(37);
+    for(size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<float>(i);
+        b[i] = static_cast<float>(2 * i + 1);
+        c[i] = 0.5f;
+        ia[i] = static_cast<std::int32_t>(i) - 10;
+        ib[i] = 3;
+    }
+
+    auto floats = make_zip_range(a, b, c);
+    auto end = exp::zip_transform(floats, out.begin(), exp::folded<std::plus<>>{});
+    EXPECT_EQ(end, out.end());
+    for(size_t i = 0; i < out.size(); ++i) {
+        EXPECT_EQ(out[i], a[i] + b[i] + c[i]);
+    }
+
+    auto ints = make_zip_range(ia, ib);
+    exp::zip_transform(ints, iout.begin(), std::multiplies<>{});
+    for(size_t i = 0; i < iout.size(); ++i) {
+        EXPECT_EQ(iout[i], ia[i] * ib[i]);
+    }
+    exp::zip_transform(ints, iout.begin(), std::minus<>{});
+    for(size_t i = 0; i < iout.size(); ++i) {
+        EXPECT_EQ(iout[i], ia[i] - ib[i]);
+    }
+
+    std::list<double> dout(37);
+    auto pairs = make_zip_range(a, b);
+    exp::zip_transform(pairs, dout.begin(), [](float x, float y) { return double(x) * y; });
+    EXPECT_EQ(dout.back(), 36.0 * 73.0);
+}
+
+TEST(zip_kernels, reduce) {
+    std::vector<double> a(101), b(101);
+    std::vector<std::int32_t> ia(101), ib(101);
+    double expected = 0;
+    std::int32_t iexpected = 0;
+    for(size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<double>(i);
+        b[i] = 2.0;
+        ia[i] = static_cast<std::int32_t>(i);
+        ib[i] = static_cast<std::int32_t>(i % 3);
+        expected += a[i] * b[i];
+        iexpected += ia[i] - ib[i];
+    }
+
+    auto doubles = make_zip_range(a, b);
+    EXPECT_EQ(exp::zip_reduce(doubles, 1.0, std::plus<>{}, std::multiplies<>{}), expected + 1.0);
+
+    auto ints = make_zip_range(ia, ib);
+    EXPECT_EQ(exp::zip_reduce(ints, std::int32_t{0}, std::plus<>{}, std::minus<>{}), iexpected);
+
+    auto max_sum = exp::zip_reduce(ints, std::int32_t{0},
+        [](std::int32_t lhs, std::int32_t rhs) { return std::max(lhs, rhs); },
+        [](std::int32_t x, std::int32_t y) { return x + y; });
+    EXPECT_EQ(max_sum, 100 + 1);
+}
+
+
+TEST(zip_kernels, operator_of_other_type_stays_scalar) {
+    // std::plus<int> truncates float operands, the batch kernels must not take it.
+    std::vector<float> a(37, 1.5f), b(37, 1.5f), out(37);
+    auto floats = make_zip_range(a, b);
+    exp::zip_transform(floats, out.begin(), std::plus<int>{});
+    std::list<float> generic(37);
+    exp::zip_transform(floats, generic.begin(), std::plus<int>{});
+    for(size_t i = 0; i < out.size(); ++i) {
+        EXPECT_EQ(out[i], 2.0f);
+    }
+    EXPECT_EQ(generic.back(), 2.0f);
+
+    exp::zip_transform(floats, out.begin(), std::multiplies<float>{});
+    EXPECT_EQ(out.back(), 2.25f);
+
+    std::vector<double> x(41, 1.5), y(41, 1.0);
+    auto doubles = make_zip_range(x, y);
+    EXPECT_EQ(exp::zip_reduce(doubles, 0.0, std::plus<int>{}, std::multiplies<double>{}), 41.0);
+    EXPECT_EQ(exp::zip_reduce(doubles, 0.0, std::plus<double>{}, std::multiplies<int>{}), 41.0);
+    EXPECT_EQ(exp::zip_reduce(doubles, 0.0, std::plus<double>{}, std::multiplies<double>{}), 41 * 1.5);
+}
+
+TEST(adaptors, fused_pipeline_over_list) {
+    exp::list<int> l{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    std::vector<int> result;
+    for(int x : l | exp::views::filter([](int x) { return x % 2 == 0; })
+                  | exp::views::transform([](int x) { return x * x; })
+                  | exp::views::take_while([](int x) { return x < 50; })) {
+        result.push_back(x);
+    }
+    EXPECT_EQ(result, (std::vector<int>{4, 16, 36}));
+
+    for(int& x : l | exp::views::stride(3)) {
+        x = 0;
+    }
+    EXPECT_EQ(std::vector<int>(l.begin(), l.end()), (std::vector<int>{0, 2, 3, 0, 5, 6, 0, 8, 9, 0}));
+}
+
+TEST(adaptors, enumerate_chunk_stride) {
+    std::vector<int> v{10, 20, 30, 40, 50, 60, 70};
+
+    std::vector<std::size_t> idx;
+    for(auto [i, x] : v | exp::views::enumerate()) {
+        EXPECT_EQ(x, v[i]);
+        idx.push_back(i);
+    }
+    EXPECT_EQ(idx, (std::vector<std::size_t>{0, 1, 2, 3, 4, 5, 6}));
+
+    std::vector<int> sums;
+    for(auto chunk : v | exp::views::chunk(3)) {
+        sums.push_back(std::accumulate(chunk.begin(), chunk.end(), 0));
+    }
+    EXPECT_EQ(sums, (std::vector<int>{60, 150, 70}));
+
+    auto strided = v | exp::views::stride(2);
+    EXPECT_EQ(std::vector<int>(strided.begin(), strided.end()), (std::vector<int>{10, 30, 50, 70}));
+
+    std::vector<int> empty;
+    auto none = empty | exp::views::chunk(4);
+    EXPECT_EQ(none.begin(), none.end());
+    auto taken = v | exp::views::take_while([](int) { return false; });
+    EXPECT_EQ(taken.begin(), taken.end());
+}
+
+TEST(adaptors, compose_with_zip_range) {
+    std::vector<int> a{1, 2, 3, 4};
+    std::vector<int> b{10, 20, 30, 40};
+
+    auto view = make_zip_range(a, b)
+        | exp::views::transform([](auto row) { return std::get<0>(row) * std::get<1>(row); })
+        | exp::views::filter([](int x) { return x > 20; });
+    EXPECT_EQ(std::vector<int>(view.begin(), view.end()), (std::vector<int>{40, 90, 160}));
+
+    auto squares = a | exp::views::transform([](int x) { return x * x; });
+    EXPECT_EQ(squares.size(), a.size());
+    std::vector<int> out;
+    for(auto [x, sq] : make_zip_range(a, squares)) {
+        out.push_back(sq - x * x);
+    }
+    EXPECT_EQ(out, (std::vector<int>{0, 0, 0, 0}));
+}
+
+TEST(adaptors, random_access_pass_through) {
+    std::vector<int> v{5, 1, 4, 2, 3};
+    auto doubled = v | exp::views::transform([](int x) { return x * 2; });
+    static_assert(std::random_access_iterator<decltype(doubled.begin())>);
+    EXPECT_EQ(doubled.begin()[2], 8);
+    EXPECT_EQ(doubled.end() - doubled.begin(), 5);
+
+    auto indexed = v | exp::views::enumerate();
+    auto [i, x] = *(indexed.begin() + 3);
+    EXPECT_EQ(i, 3);
+    EXPECT_EQ(x, 2);
+
+    exp::list<int> l{1, 2, 3};
+    auto squares = l | exp::views::transform([](int x) { return x * x; });
+    static_assert(!std::random_access_iterator<decltype(squares.begin())>);
+    static_assert(std::bidirectional_iterator<decltype(squares.begin())>);
+}
 
 
 int main(int argc, char **argv) {
@@ -0,0 +1,445 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <iterator>
+#include <utility>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include <initializer_list>
+#include "iterator.hpp"
+#include "allocation_stats.hpp"
+
+namespace exp {
+
+// Doubly linked list of chunks, each chunk holds up to chunk_capacity elements
+// stored contiguously. Inserting or erasing shifts elements only inside one chunk
+// and invalidates iterators into that chunk (and into the new chunk on a split).
+template<typename T, std::size_t ChunkBytes = 64, typename Allocator = default_allocator<T>>
+class unrolled_list {
+public:
+	static constexpr std::size_t chunk_capacity = ChunkBytes / sizeof(T) > 0 ? ChunkBytes / sizeof(T) : 1;
+
+	struct BaseChunk {
+		BaseChunk* next_ = nullptr;
+		BaseChunk* prev_ = nullptr;
+		std::size_t count_{};
+	};
+
+	class Chunk: public BaseChunk {
+	public:
+		using payload_type = T[chunk_capacity];
+
+		T* data() noexcept { return std::launder(reinterpret_cast<T*>(storage_)); }
+		const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(storage_)); }
+
+		bool full() const noexcept { return this->count_ == chunk_capacity; }
+	private:
+		alignas(T) std::byte storage_[chunk_capacity * sizeof(T)];
+	};
+
+	using value_type = T;
+	using allocator_type = Allocator;
+
+	// ============= Iterator ============= //
+
+	template<bool isConst>
+	class unrolled_iterator: public iterator_facade<unrolled_iterator<isConst>, std::conditional_t<isConst, const T, T>, std::bidirectional_iterator_tag> {
+		using BaseType = iterator_facade<unrolled_iterator<isConst>, std::conditional_t<isConst, const T, T>, std::bidirectional_iterator_tag>;
+		friend unrolled_list;
+	public:
+		using value_type = typename BaseType::value_type;
+		using reference = typename BaseType::reference;
+		using pointer = std::conditional_t<isConst, const value_type*, value_type*>;
+		using iterator_category = typename BaseType::iterator_category;
+		using difference_type = typename BaseType::difference_type;
+
+		using base_chunk_pointer = std::conditional_t<isConst, const BaseChunk*, BaseChunk*>;
+		using chunk_pointer = std::conditional_t<isConst, const Chunk*, Chunk*>;
+
+		unrolled_iterator() noexcept = default;
+		unrolled_iterator(base_chunk_pointer chunk, std::size_t index) noexcept: chunk_(chunk), index_(index) {}
+
+		template<bool wasConst> requires (isConst && !wasConst)
+		unrolled_iterator(const unrolled_iterator<wasConst>& other) noexcept: chunk_(other.chunk_), index_(other.index_) {}
+
+		reference dereference() const noexcept { return static_cast<chunk_pointer>(chunk_)->data()[index_]; }
+
+		void increment() noexcept {
+			if(++index_ == chunk_->count_) {
+				chunk_ = chunk_->next_;
+				index_ = 0;
+			}
+		}
+
+		void decrement() noexcept {
+			if(index_ == 0) {
+				chunk_ = chunk_->prev_;
+				index_ = chunk_->count_ - 1;
+			} else {
+				--index_;
+			}
+		}
+
+		bool equal(const unrolled_iterator& rhs) const noexcept { return chunk_ == rhs.chunk_ && index_ == rhs.index_; }
+	private:
+		template<bool> friend class unrolled_iterator;
+
+		base_chunk_pointer chunk_ = nullptr;
+		std::size_t index_{};
+	};
+
+	// ==================================== //
+
+	using iterator = unrolled_iterator<false>;
+	using const_iterator = unrolled_iterator<true>;
+
+	iterator begin() noexcept { return iterator(begin_.next_, 0); }
+	const_iterator begin() const noexcept { return cbegin(); }
+	const_iterator cbegin() const noexcept { return const_iterator(begin_.next_, 0); }
+
+	iterator end() noexcept { return iterator(&begin_, 0); }
+	const_iterator end() const noexcept { return cend(); }
+	const_iterator cend() const noexcept { return const_iterator(&begin_, 0); }
+
+	unrolled_list(): unrolled_list(Allocator()) {}
+
+	explicit unrolled_list(const Allocator& alloc): alloc_(alloc) {
+		begin_.next_ = &begin_;
+		begin_.prev_ = &begin_;
+	}
+
+	unrolled_list(std::initializer_list<T> init_list): unrolled_list() {
+		append(init_list.begin(), init_list.end());
+	}
+
+	template<std::input_iterator It>
+	unrolled_list(It first, It last): unrolled_list() {
+		append(first, last);
+	}
+
+	unrolled_list(const unrolled_list& other): unrolled_list(Allocator(chunk_traits::select_on_container_copy_construction(other.alloc_))) {
+		append(other.begin(), other.end());
+	}
+
+	unrolled_list(unrolled_list&& other) noexcept: unrolled_list(Allocator(other.alloc_)) {
+		moveRing(begin_, other.begin_);
+		size_ = std::exchange(other.size_, 0);
+	}
+
+	unrolled_list& operator=(unrolled_list other) noexcept {
+		swap(other);
+		return *this;
+	}
+
+	~unrolled_list() { clear(); }
+
+	void swap(unrolled_list& other) noexcept {
+		using std::swap;
+		BaseChunk ring;
+		moveRing(ring, begin_);
+		moveRing(begin_, other.begin_);
+		moveRing(other.begin_, ring);
+		swap(size_, other.size_);
+		swap(alloc_, other.alloc_);
+	}
+
+	friend void swap(unrolled_list& lhs, unrolled_list& rhs) noexcept { lhs.swap(rhs); }
+
+	size_t size() const noexcept { return size_; }
+	bool empty() const noexcept { return size_ == 0; }
+
+	allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+	T& front() noexcept { return *begin(); }
+	const T& front() const noexcept { return *begin(); }
+	T& back() noexcept { return *std::prev(end()); }
+	const T& back() const noexcept { return *std::prev(end()); }
+
+	template<typename... Args>
+	iterator emplace(iterator pos, Args&&... args) {
+		if(pos.chunk_ == &begin_) {
+			emplace_back(std::forward<Args>(args)...);
+			return std::prev(end());
+		}
+
+		auto* chunk = static_cast<Chunk*>(pos.chunk_);
+		std::size_t idx = pos.index_;
+
+		if(chunk->full()) {
+			if(idx == 0) {
+				BaseChunk* prev = chunk->prev_;
+				if(prev == &begin_ || static_cast<Chunk*>(prev)->full()) {
+					return iterator(linkNewChunkBefore(chunk, [&](Chunk* fresh) {
+						constructAt(fresh, 0, std::forward<Args>(args)...);
+					}), 0);
+				}
+				auto* target = static_cast<Chunk*>(prev);
+				constructAt(target, target->count_, std::forward<Args>(args)...);
+				return iterator(target, target->count_ - 1);
+			}
+			// args may refer to an element, which the split relocates.
+			T value(std::forward<Args>(args)...);
+			Chunk* upper = splitChunk(chunk);
+			if(idx > chunk->count_) {
+				idx -= chunk->count_;
+				chunk = upper;
+			}
+			insertInChunk(chunk, idx, std::move(value));
+			return iterator(chunk, idx);
+		}
+
+		insertInChunk(chunk, idx, std::forward<Args>(args)...);
+		return iterator(chunk, idx);
+	}
+
+	iterator insert(iterator pos, const T& val) { return emplace(pos, val); }
+	iterator insert(iterator pos, T&& val) { return emplace(pos, std::move(val)); }
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args) {
+		BaseChunk* last = begin_.prev_;
+		if(last == &begin_ || static_cast<Chunk*>(last)->full()) {
+			return linkNewChunkBefore(&begin_, [&](Chunk* fresh) {
+				constructAt(fresh, 0, std::forward<Args>(args)...);
+			})->data()[0];
+		}
+		auto* chunk = static_cast<Chunk*>(last);
+		constructAt(chunk, chunk->count_, std::forward<Args>(args)...);
+		return chunk->data()[chunk->count_ - 1];
+	}
+
+	template<typename... Args>
+	T& emplace_front(Args&&... args) { return *emplace(begin(), std::forward<Args>(args)...); }
+
+	void push_back(const T& val) { emplace_back(val); }
+	void push_back(T&& val) { emplace_back(std::move(val)); }
+
+	void push_front(const T& val) { emplace_front(val); }
+	void push_front(T&& val) { emplace_front(std::move(val)); }
+
+	// Fills the tail chunk and then whole chunks, one chunk allocation per chunk_capacity elements.
+	template<std::input_iterator It>
+	void append(It first, It last) {
+		auto fill = [this, &first, &last](Chunk* chunk) {
+			if constexpr (std::random_access_iterator<It>) {
+				const auto n = std::min<std::size_t>(chunk_capacity - chunk->count_, static_cast<std::size_t>(last - first));
+				std::uninitialized_copy_n(first, n, chunk->data() + chunk->count_);
+				chunk->count_ += n;
+				size_ += n;
+				first += n;
+			} else {
+				while(first != last && !chunk->full()) {
+					constructAt(chunk, chunk->count_, *first);
+					++first;
+				}
+			}
+		};
+		while(first != last) {
+			BaseChunk* tail = begin_.prev_;
+			if(tail == &begin_ || static_cast<Chunk*>(tail)->full()) {
+				linkNewChunkBefore(&begin_, fill);
+			} else {
+				fill(static_cast<Chunk*>(tail));
+			}
+		}
+	}
+
+	iterator erase(iterator pos) noexcept {
+		auto* chunk = static_cast<Chunk*>(pos.chunk_);
+		const std::size_t idx = pos.index_;
+
+		eraseInChunk(chunk, idx);
+
+		if(chunk->count_ == 0) {
+			BaseChunk* next = chunk->next_;
+			unlinkChunk(chunk);
+			destroyChunk(chunk);
+			return iterator(next, 0);
+		}
+
+		BaseChunk* next = chunk->next_;
+		if(next != &begin_ && chunk->count_ + next->count_ <= chunk_capacity) {
+			mergeNext(chunk);
+		}
+
+		if(idx == chunk->count_) {
+			return iterator(chunk->next_, 0);
+		}
+		return iterator(chunk, idx);
+	}
+
+	void pop_back() noexcept { erase(std::prev(end())); }
+	void pop_front() noexcept { erase(begin()); }
+
+	void clear() noexcept {
+		BaseChunk* curr = begin_.next_;
+		while(curr != &begin_) {
+			BaseChunk* next = curr->next_;
+			auto* chunk = static_cast<Chunk*>(curr);
+			std::destroy_n(chunk->data(), chunk->count_);
+			destroyChunk(chunk);
+			curr = next;
+		}
+		begin_.next_ = &begin_;
+		begin_.prev_ = &begin_;
+		size_ = 0;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const unrolled_list& list) {
+		for(const auto& el : list) {
+			os << el << ' ';
+		}
+		return os;
+	}
+
+	friend bool operator==(const unrolled_list& rhs, const unrolled_list& lhs) noexcept {
+		return rhs.size() == lhs.size() && std::equal(rhs.begin(), rhs.end(), lhs.begin());
+	}
+	friend bool operator!=(const unrolled_list& rhs, const unrolled_list& lhs) noexcept {
+		return !(rhs == lhs);
+	}
+
+private:
+	using chunk_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+	using chunk_traits = std::allocator_traits<chunk_allocator>;
+
+	static constexpr bool trivially_relocatable = std::is_trivially_copyable_v<T>;
+
+	Chunk* createChunk() {
+		Chunk* chunk = chunk_traits::allocate(alloc_, 1);
+		chunk_traits::construct(alloc_, chunk);
+		return chunk;
+	}
+
+	void destroyChunk(Chunk* chunk) noexcept {
+		chunk_traits::destroy(alloc_, chunk);
+		chunk_traits::deallocate(alloc_, chunk, 1);
+	}
+
+	BaseChunk* linkChunkBefore(Chunk* chunk, BaseChunk* curr) noexcept {
+		BaseChunk* prev = curr->prev_;
+		chunk->next_ = curr;
+		chunk->prev_ = prev;
+		prev->next_ = chunk;
+		curr->prev_ = chunk;
+		return chunk;
+	}
+
+	// Fills a new chunk and links it before curr only once it holds elements, so
+	// a throwing element constructor never leaves an empty chunk in the ring.
+	template<typename Fill>
+	Chunk* linkNewChunkBefore(BaseChunk* curr, Fill&& fill) {
+		Chunk* chunk = createChunk();
+		try {
+			fill(chunk);
+		} catch(...) {
+			if(chunk->count_ == 0) {
+				destroyChunk(chunk);
+			} else {
+				linkChunkBefore(chunk, curr);
+			}
+			throw;
+		}
+		linkChunkBefore(chunk, curr);
+		return chunk;
+	}
+
+	// Hands the chunks of from's ring to the sentinel to, leaving from empty.
+	static void moveRing(BaseChunk& to, BaseChunk& from) noexcept {
+		if(from.next_ == &from) {
+			to.next_ = &to;
+			to.prev_ = &to;
+			return;
+		}
+		to.next_ = from.next_;
+		to.prev_ = from.prev_;
+		to.next_->prev_ = &to;
+		to.prev_->next_ = &to;
+		from.next_ = &from;
+		from.prev_ = &from;
+	}
+
+	void unlinkChunk(BaseChunk* chunk) noexcept {
+		chunk->prev_->next_ = chunk->next_;
+		chunk->next_->prev_ = chunk->prev_;
+	}
+
+	template<typename... Args>
+	void constructAt(Chunk* chunk, std::size_t idx, Args&&... args) {
+		std::construct_at(chunk->data() + idx, std::forward<Args>(args)...);
+		++chunk->count_;
+		++size_;
+	}
+
+	template<typename... Args>
+	void insertInChunk(Chunk* chunk, std::size_t idx, Args&&... args) {
+		T* data = chunk->data();
+		const std::size_t count = chunk->count_;
+		if(idx == count) {
+			constructAt(chunk, idx, std::forward<Args>(args)...);
+			return;
+		}
+		if constexpr (trivially_relocatable) {
+			T value(std::forward<Args>(args)...);
+			std::memmove(static_cast<void*>(data + idx + 1), static_cast<const void*>(data + idx), (count - idx) * sizeof(T));
+			std::construct_at(data + idx, std::move(value));
+		} else {
+			T value(std::forward<Args>(args)...);
+			std::construct_at(data + count, std::move(data[count - 1]));
+			std::move_backward(data + idx, data + count - 1, data + count);
+			data[idx] = std::move(value);
+		}
+		++chunk->count_;
+		++size_;
+	}
+
+	void eraseInChunk(Chunk* chunk, std::size_t idx) noexcept {
+		T* data = chunk->data();
+		const std::size_t count = chunk->count_;
+		if constexpr (trivially_relocatable) {
+			std::memmove(static_cast<void*>(data + idx), static_cast<const void*>(data + idx + 1), (count - idx - 1) * sizeof(T));
+		} else {
+			std::move(data + idx + 1, data + count, data + idx);
+			std::destroy_at(data + count - 1);
+		}
+		--chunk->count_;
+		--size_;
+	}
+
+	// Moves elements [from, count) of src to the end of dst.
+	static void relocate(Chunk* src, std::size_t from, Chunk* dst) noexcept {
+		const std::size_t n = src->count_ - from;
+		if constexpr (trivially_relocatable) {
+			std::memcpy(static_cast<void*>(dst->data() + dst->count_), static_cast<const void*>(src->data() + from), n * sizeof(T));
+		} else {
+			std::uninitialized_move_n(src->data() + from, n, dst->data() + dst->count_);
+			std::destroy_n(src->data() + from, n);
+		}
+		dst->count_ += n;
+		src->count_ = from;
+	}
+
+	Chunk* splitChunk(Chunk* chunk) {
+		auto* upper = static_cast<Chunk*>(linkChunkBefore(createChunk(), chunk->next_));
+		relocate(chunk, chunk->count_ / 2, upper);
+		return upper;
+	}
+
+	void mergeNext(Chunk* chunk) noexcept {
+		auto* next = static_cast<Chunk*>(chunk->next_);
+		relocate(next, 0, chunk);
+		unlinkChunk(next);
+		destroyChunk(next);
+	}
+
+	BaseChunk begin_;
+	size_t size_{};
+	[[no_unique_address]] chunk_allocator alloc_;
+};
+
+} // namespace exp
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <atomic>
+#include <thread>
+#include <future>
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <concepts>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+#include "concurrent_list.hpp"
+#include "prng.hpp"
+
+namespace exp {
+
+namespace details {
+
+class task_base {
+public:
+    virtual ~task_base() = default;
+    virtual void run() = 0;
+};
+
+template<typename F>
+class task: public task_base {
+public:
+    explicit task(F&& func): func_(std::move(func)) {}
+    void run() override { func_(); }
+private:
+    F func_;
+};
+
+} // namespace details
+
+// Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli, PPoPP'13).
+// The owner pushes and pops at the bottom, any thread steals from the top.
+// Buffers replaced on growth are kept until destruction since thieves may still read them.
+template<typename T>
+class chase_lev_deque {
+public:
+    explicit chase_lev_deque(std::size_t capacity = 256) {
+        buffers_.push_back(std::make_unique<Buffer>(capacity));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    chase_lev_deque(const chase_lev_deque&) = delete;
+    chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+    // Owner only.
+    void push(T* item) {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if(bottom - top > static_cast<std::int64_t>(buffer->mask_)) {
+            buffer = grow(buffer, top, bottom);
+        }
+        buffer->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only.
+    T* pop() {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_relaxed);
+
+        if(top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* item = buffer->get(bottom);
+        if(top == bottom) {
+            if(!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    T* steal() {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if(top >= bottom) {
+            return nullptr;
+        }
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        T* item = buffer->get(top);
+        if(!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    bool empty() const noexcept {
+        return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(std::size_t capacity): mask_(capacity - 1), items_(std::make_unique<std::atomic<T*>[]>(capacity)) {}
+
+        T* get(std::int64_t idx) const noexcept { return items_[static_cast<std::size_t>(idx) & mask_].load(std::memory_order_relaxed); }
+        void put(std::int64_t idx, T* item) noexcept { items_[static_cast<std::size_t>(idx) & mask_].store(item, std::memory_order_relaxed); }
+
+        std::size_t mask_;
+        std::unique_ptr<std::atomic<T*>[]> items_;
+    };
+
+    Buffer* grow(Buffer* old, std::int64_t top, std::int64_t bottom) {
+        buffers_.push_back(std::make_unique<Buffer>((old->mask_ + 1) * 2));
+        Buffer* buffer = buffers_.back().get();
+        for(std::int64_t idx = top; idx < bottom; ++idx) {
+            buffer->put(idx, old->get(idx));
+        }
+        buffer_.store(buffer, std::memory_order_release);
+        return buffer;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    alignas(64) std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+// Thread pool where every worker owns a Chase-Lev deque. Tasks spawned by a
+// worker go to its own deque, tasks submitted from outside go to a lock-free
+// injection queue, idle workers steal from random victims.
+class work_stealing_pool {
+public:
+    explicit work_stealing_pool(std::size_t threads = std::thread::hardware_concurrency()) {
+        const std::size_t count = threads > 0 ? threads : 1;
+        workers_.reserve(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            workers_.push_back(std::make_unique<Worker>());
+        }
+        for(std::size_t i = 0; i < count; ++i) {
+            workers_[i]->thread_ = std::thread([this, i]() { workerLoop(i); });
+        }
+    }
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    ~work_stealing_pool() { shutdown(); }
+
+    std::size_t size() const noexcept { return workers_.size(); }
+
+    // Runs every task that was already submitted, then stops and joins the workers.
+    void shutdown() {
+        if(stop_.exchange(true)) {
+            return;
+        }
+        // A submit() that saw stop_ unset may still be pushing, and workers that
+        // found nothing to do exit without waiting for it.
+        while(submitting_.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+        wakeWorkers(true);
+        for(auto& worker : workers_) {
+            worker->thread_.join();
+        }
+        while(auto item = injected_.try_pop()) {
+            execute(*item);
+        }
+    }
+
+    template<typename F, typename... Args>
+    auto submit(F&& func, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+        using Result = std::invoke_result_t<F, Args...>;
+        std::packaged_task<Result()> packaged(
+            [func = std::forward<F>(func), ...args = std::forward<Args>(args)]() mutable -> Result {
+                return std::invoke(std::move(func), std::move(args)...);
+            });
+        auto future = packaged.get_future();
+        spawn(std::move(packaged));
+        return future;
+    }
+
+    // Calls func(idx) for every idx in [first, last), splitting the range in halves
+    // down to grain indices. Blocks until done, helping with queued work meanwhile.
+    template<std::integral Index, typename F>
+    void parallel_for(Index first, Index last, F&& func, Index grain = 0) {
+        if(first >= last) {
+            return;
+        }
+        if(grain <= 0) {
+            grain = std::max<Index>(1, static_cast<Index>((last - first) / static_cast<Index>(size() * 8)));
+        }
+
+        ForState<F> state(func, static_cast<std::size_t>(grain));
+        state.pending_.store(1, std::memory_order_relaxed);
+        runRange(state, first, last);
+        waitFor(state.pending_);
+
+        if(state.error_) {
+            std::rethrow_exception(state.error_);
+        }
+    }
+
+    // Calls func(*it) for every element. Random-access ranges are split by index,
+    // other ranges (exp::list, zip_range over lists) are walked to cut them into chunks.
+    template<std::forward_iterator It, typename F>
+    void parallel_for(It first, It last, F&& func) {
+        if constexpr (std::random_access_iterator<It>) {
+            parallel_for(std::ptrdiff_t{0}, static_cast<std::ptrdiff_t>(last - first), [&](std::ptrdiff_t idx) { func(first[idx]); });
+        } else {
+            std::size_t n{};
+            for(It it = first; it != last; ++it) {
+                ++n;
+            }
+            std::vector<It> bounds = splitRange(first, last, n);
+            parallel_for(std::size_t{0}, bounds.size() - 1, [&](std::size_t chunk) {
+                for(It it = bounds[chunk]; it != bounds[chunk + 1]; ++it) {
+                    func(*it);
+                }
+            }, std::size_t{1});
+        }
+    }
+
+    // Chunk boundaries of a range of n elements, about 8 chunks per worker.
+    template<std::forward_iterator It>
+    std::vector<It> splitRange(It first, It last, std::size_t n) const {
+        const std::size_t chunk = std::max<std::size_t>(1, n / (size() * 8));
+        std::vector<It> bounds;
+        bounds.reserve(n / chunk + 2);
+        bounds.push_back(first);
+        for(std::size_t idx = 0; first != last; ++idx, ++first) {
+            if(idx != 0 && idx % chunk == 0) {
+                bounds.push_back(first);
+            }
+        }
+        bounds.push_back(last);
+        return bounds;
+    }
+
+private:
+    struct alignas(64) Worker {
+        chase_lev_deque<details::task_base> deque_;
+        std::thread thread_;
+    };
+
+    template<typename F>
+    struct ForState {
+        ForState(F& func, std::size_t grain) noexcept: func_(func), grain_(grain) {}
+
+        F& func_;
+        std::size_t grain_;
+        std::atomic<std::size_t> pending_{0};
+        std::atomic<bool> failed_{false};
+        std::exception_ptr error_;
+    };
+
+    struct ThreadContext {
+        work_stealing_pool* pool_ = nullptr;
+        std::size_t index_{};
+    };
+
+    static ThreadContext& context() noexcept {
+        static thread_local ThreadContext ctx;
+        return ctx;
+    }
+
+    template<typename F>
+    void spawn(F&& func) {
+        auto* item = new details::task<std::decay_t<F>>(std::forward<F>(func));
+        ThreadContext& ctx = context();
+        if(ctx.pool_ == this) {
+            workers_[ctx.index_]->deque_.push(item);
+        } else {
+            submitting_.fetch_add(1, std::memory_order_seq_cst);
+            if(stop_.load(std::memory_order_seq_cst)) {
+                submitting_.fetch_sub(1, std::memory_order_release);
+                delete item;
+                throw std::runtime_error("work_stealing_pool: submit after shutdown");
+            }
+            injected_.push(item);
+            submitting_.fetch_sub(1, std::memory_order_release);
+        }
+        wakeWorkers(false);
+    }
+
+    template<typename State, typename Index>
+    void runRange(State& state, Index first, Index last) {
+        while(static_cast<std::size_t>(last - first) > state.grain_) {
+            const Index mid = first + (last - first) / 2;
+            state.pending_.fetch_add(1, std::memory_order_relaxed);
+            try {
+                spawn([this, &state, mid, last]() { runRange(state, mid, last); });
+            } catch(...) {
+                // Out of memory or the pool shut down: the rest runs here, so no
+                // task outlives the state it points to.
+                state.pending_.fetch_sub(1, std::memory_order_relaxed);
+                break;
+            }
+            last = mid;
+        }
+        if(!state.failed_.load(std::memory_order_relaxed)) {
+            try {
+                for(Index idx = first; idx < last; ++idx) {
+                    state.func_(idx);
+                }
+            } catch(...) {
+                if(!state.failed_.exchange(true)) {
+                    state.error_ = std::current_exception();
+                }
+            }
+        }
+        state.pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void waitFor(const std::atomic<std::size_t>& pending) {
+        while(pending.load(std::memory_order_acquire) != 0) {
+            if(details::task_base* item = findTask()) {
+                execute(item);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    details::task_base* findTask() {
+        ThreadContext& ctx = context();
+        const bool is_worker = ctx.pool_ == this;
+        if(is_worker) {
+            if(auto* item = workers_[ctx.index_]->deque_.pop()) {
+                return item;
+            }
+        }
+        if(auto item = injected_.try_pop()) {
+            return *item;
+        }
+
+        static thread_local xoshiro256 rng(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        const std::size_t count = workers_.size();
+        const std::size_t start = uniform_int<std::size_t>(rng, 0, count - 1);
+        for(std::size_t i = 0; i < count; ++i) {
+            const std::size_t victim = (start + i) % count;
+            if(is_worker && victim == ctx.index_) {
+                continue;
+            }
+            if(auto* item = workers_[victim]->deque_.steal()) {
+                return item;
+            }
+        }
+        return nullptr;
+    }
+
+    static void execute(details::task_base* item) {
+        std::unique_ptr<details::task_base> owned(item);
+        owned->run();
+    }
+
+    void wakeWorkers(bool all) {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if(all) {
+            epoch_.notify_all();
+        } else if(sleepers_.load(std::memory_order_seq_cst) > 0) {
+            epoch_.notify_one();
+        }
+    }
+
+    void workerLoop(std::size_t index) {
+        context() = ThreadContext{this, index};
+        for(;;) {
+            const std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+            if(details::task_base* item = findTask()) {
+                execute(item);
+                continue;
+            }
+            if(stop_.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            sleepers_.fetch_add(1, std::memory_order_seq_cst);
+            if(details::task_base* item = findTask()) {
+                sleepers_.fetch_sub(1, std::memory_order_relaxed);
+                execute(item);
+                continue;
+            }
+            epoch_.wait(epoch, std::memory_order_seq_cst);
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    concurrent_queue<details::task_base*> injected_;
+    alignas(64) std::atomic<std::uint64_t> epoch_{0};
+    alignas(64) std::atomic<std::size_t> sleepers_{0};
+    std::atomic<bool> stop_{false};
+    std::atomic<std::size_t> submitting_{0};
+};
+
+} // namespace exp
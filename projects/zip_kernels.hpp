@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2026 VasilyMarkov
+ * Licensed under the MIT License.
+ * See LICENSE file in the project root for full license information.
+ */
+
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "iterator.hpp"
+#include "instrumentation.hpp"
+
+// Kernels over zip_range that skip zip_iterator when every range is contiguous.
+// They run plain index loops over the underlying pointers, which the compiler can
+// vectorize, and hand element-wise +, - and * on float, double and int32 columns
+// to explicit batch kernels: AVX2 when the CPU has it, 16-byte vectors (SSE2 on
+// x86-64) otherwise, scalar code on compilers without GNU vector extensions.
+
+#if defined(__GNUC__)
+#define EXP_SIMD_VECTORS 1
+#if defined(__x86_64__) || defined(__i386__)
+#define EXP_SIMD_AVX2_DISPATCH 1
+#endif
+#endif
+
+namespace exp {
+
+// Left fold of a binary op over all arguments, folded<std::plus<>>{}(a, b, c) == (a + b) + c.
+// Lets the batch kernels take more than two columns.
+template<typename Op>
+struct folded {
+    template<typename T, typename... Rest>
+    constexpr T operator()(const T& first, const Rest&... rest) const {
+        T acc = first;
+        ((acc = Op{}(acc, rest)), ...);
+        return acc;
+    }
+};
+
+namespace details {
+
+enum class simd_op { none, plus, minus, multiplies };
+
+// Batch op of F on elements of type T. Only the transparent operators and those
+// of T itself qualify: std::plus<int> on float columns converts to int first.
+template<typename F, typename T>
+inline constexpr simd_op simd_op_of = simd_op::none;
+template<typename T>
+inline constexpr simd_op simd_op_of<std::plus<T>, T> = simd_op::plus;
+template<typename T>
+inline constexpr simd_op simd_op_of<std::plus<>, T> = simd_op::plus;
+template<typename T>
+inline constexpr simd_op simd_op_of<std::minus<T>, T> = simd_op::minus;
+template<typename T>
+inline constexpr simd_op simd_op_of<std::minus<>, T> = simd_op::minus;
+template<typename T>
+inline constexpr simd_op simd_op_of<std::multiplies<T>, T> = simd_op::multiplies;
+template<typename T>
+inline constexpr simd_op simd_op_of<std::multiplies<>, T> = simd_op::multiplies;
+
+template<typename F>
+inline constexpr bool is_folded = false;
+template<typename Op>
+inline constexpr bool is_folded<folded<Op>> = true;
+
+template<typename Op, typename T>
+inline constexpr simd_op simd_op_of<folded<Op>, T> = simd_op_of<Op, T>;
+
+template<typename T>
+concept simd_element = std::same_as<T, float> || std::same_as<T, double> || std::same_as<T, std::int32_t>;
+
+// F applied to columns of Ts can go through the batch kernels with result type T.
+template<typename F, typename T, typename... Ts>
+concept simd_foldable = simd_op_of<F, T> != simd_op::none && simd_element<T> && (std::same_as<Ts, T> && ...)
+    && (sizeof...(Ts) == 2 || (is_folded<F> && sizeof...(Ts) >= 2));
+
+template<simd_op Op, typename V>
+[[gnu::always_inline]] inline void combine(V& acc, const V& rhs) noexcept {
+    if constexpr (Op == simd_op::plus) {
+        acc = acc + rhs;
+    } else if constexpr (Op == simd_op::minus) {
+        acc = acc - rhs;
+    } else {
+        acc = acc * rhs;
+    }
+}
+
+template<simd_op Op, typename T, std::size_t N>
+[[gnu::always_inline]] inline T fold_row(const T* const* cols, std::size_t idx) noexcept {
+    T acc = cols[0][idx];
+    for(std::size_t col = 1; col < N; ++col) {
+        combine<Op>(acc, cols[col][idx]);
+    }
+    return acc;
+}
+
+#if defined(EXP_SIMD_VECTORS)
+template<typename T, std::size_t Bytes>
+struct simd_vec {
+    typedef T type __attribute__((vector_size(Bytes)));
+};
+
+// Vectors are only passed by reference so no function has a vector in its ABI.
+template<simd_op Op, typename V, typename T, std::size_t N>
+[[gnu::always_inline]] inline void fold_batch(V& acc, const T* const* cols, std::size_t idx) noexcept {
+    std::memcpy(&acc, cols[0] + idx, sizeof(V));
+    for(std::size_t col = 1; col < N; ++col) {
+        V rhs;
+        std::memcpy(&rhs, cols[col] + idx, sizeof(V));
+        combine<Op>(acc, rhs);
+    }
+}
+
+// out[i] = cols[0][i] op cols[1][i] op ...
+template<simd_op Op, typename T, std::size_t Bytes, std::size_t N>
+[[gnu::always_inline]] inline void fold_columns_batches(const T* const* cols, T* out, std::size_t n) noexcept {
+    using V = typename simd_vec<T, Bytes>::type;
+    constexpr std::size_t width = Bytes / sizeof(T);
+    std::size_t idx = 0;
+    for(; idx + width <= n; idx += width) {
+        V acc;
+        fold_batch<Op, V, T, N>(acc, cols, idx);
+        std::memcpy(out + idx, &acc, sizeof(V));
+    }
+    for(; idx < n; ++idx) {
+        out[idx] = fold_row<Op, T, N>(cols, idx);
+    }
+}
+
+// Sum over i of cols[0][i] op cols[1][i] op ..., two accumulators hide the add latency.
+template<simd_op Op, typename T, std::size_t Bytes, std::size_t N>
+[[gnu::always_inline]] inline T fold_columns_sum_batches(const T* const* cols, std::size_t n) noexcept {
+    using V = typename simd_vec<T, Bytes>::type;
+    constexpr std::size_t width = Bytes / sizeof(T);
+    V sum0 = {};
+    V sum1 = {};
+    std::size_t idx = 0;
+    for(; idx + 2 * width <= n; idx += 2 * width) {
+        V row0;
+        V row1;
+        fold_batch<Op, V, T, N>(row0, cols, idx);
+        fold_batch<Op, V, T, N>(row1, cols, idx + width);
+        sum0 = sum0 + row0;
+        sum1 = sum1 + row1;
+    }
+    for(; idx + width <= n; idx += width) {
+        V row;
+        fold_batch<Op, V, T, N>(row, cols, idx);
+        sum0 = sum0 + row;
+    }
+    sum0 = sum0 + sum1;
+    T sum{};
+    for(std::size_t lane = 0; lane < width; ++lane) {
+        sum += sum0[lane];
+    }
+    for(; idx < n; ++idx) {
+        sum += fold_row<Op, T, N>(cols, idx);
+    }
+    return sum;
+}
+#endif
+
+#if defined(EXP_SIMD_AVX2_DISPATCH)
+template<simd_op Op, typename T, std::size_t N>
+[[gnu::target("avx2")]] void fold_columns_avx2(const T* const* cols, T* out, std::size_t n) noexcept {
+    fold_columns_batches<Op, T, 32, N>(cols, out, n);
+}
+
+template<simd_op Op, typename T, std::size_t N>
+[[gnu::target("avx2")]] T fold_columns_sum_avx2(const T* const* cols, std::size_t n) noexcept {
+    return fold_columns_sum_batches<Op, T, 32, N>(cols, n);
+}
+
+inline bool has_avx2() noexcept {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+template<simd_op Op, typename T, std::size_t N>
+void fold_columns(const T* const* cols, T* out, std::size_t n) noexcept {
+#if defined(EXP_SIMD_AVX2_DISPATCH)
+    if(has_avx2()) {
+        fold_columns_avx2<Op, T, N>(cols, out, n);
+        return;
+    }
+#endif
+#if defined(EXP_SIMD_VECTORS)
+    fold_columns_batches<Op, T, 16, N>(cols, out, n);
+#else
+    for(std::size_t idx = 0; idx < n; ++idx) {
+        out[idx] = fold_row<Op, T, N>(cols, idx);
+    }
+#endif
+}
+
+template<simd_op Op, typename T, std::size_t N>
+T fold_columns_sum(const T* const* cols, std::size_t n) noexcept {
+#if defined(EXP_SIMD_AVX2_DISPATCH)
+    if(has_avx2()) {
+        return fold_columns_sum_avx2<Op, T, N>(cols, n);
+    }
+#endif
+#if defined(EXP_SIMD_VECTORS)
+    return fold_columns_sum_batches<Op, T, 16, N>(cols, n);
+#else
+    T sum{};
+    for(std::size_t idx = 0; idx < n; ++idx) {
+        sum += fold_row<Op, T, N>(cols, idx);
+    }
+    return sum;
+#endif
+}
+
+// Calls f with the begin iterator of every range of the zip.
+template<typename Zip, typename F>
+decltype(auto) with_begins(Zip& range, F&& f) {
+    return [&]<std::size_t... I>(std::index_sequence<I...>) -> decltype(auto) {
+        return f(std::begin(range.template get<I>())...);
+    }(std::make_index_sequence<Zip::columns>{});
+}
+
+} // namespace details
+
+// Calls f(a[i], b[i], ...) for every row, elements are passed by reference.
+template<typename... Ranges, typename F>
+void zip_for_each(zip_range<Ranges...>& range, F f) {
+    EXP_TRACE_SCOPE("exp::zip_for_each");
+    const std::size_t n = range.size();
+    details::with_begins(range, [&](auto... its) {
+        if constexpr (zip_range<Ranges...>::is_contiguous) {
+            [&](auto*... cols) {
+                for(std::size_t idx = 0; idx < n; ++idx) {
+                    f(cols[idx]...);
+                }
+            }(std::to_address(its)...);
+        } else {
+            for(std::size_t idx = 0; idx < n; ++idx, (++its, ...)) {
+                f(*its...);
+            }
+        }
+    });
+}
+
+// out[i] = f(a[i], b[i], ...), returns the end of the written range.
+template<typename... Ranges, typename OutIt, typename F>
+OutIt zip_transform(zip_range<Ranges...>& range, OutIt out, F f) {
+    EXP_TRACE_SCOPE("exp::zip_transform");
+    const std::size_t n = range.size();
+    details::with_begins(range, [&](auto... its) {
+        if constexpr (zip_range<Ranges...>::is_contiguous && std::contiguous_iterator<OutIt>) {
+            auto* dst = std::to_address(out);
+            using T = std::remove_cvref_t<decltype(*dst)>;
+            if constexpr (details::simd_foldable<F, T, std::iter_value_t<decltype(its)>...>) {
+                const T* cols[] = {std::to_address(its)...};
+                details::fold_columns<details::simd_op_of<F, T>, T, sizeof...(its)>(cols, dst, n);
+            } else {
+                [&](auto*... cols) {
+                    for(std::size_t idx = 0; idx < n; ++idx) {
+                        dst[idx] = f(cols[idx]...);
+                    }
+                }(std::to_address(its)...);
+            }
+            std::advance(out, n);
+        } else {
+            for(std::size_t idx = 0; idx < n; ++idx, (++its, ...), ++out) {
+                *out = f(*its...);
+            }
+        }
+    });
+    return out;
+}
+
+// reduce(... reduce(init, transform(row 0)) ..., transform(row n - 1)). Reordered into
+// vector lanes when reduce is std::plus and transform is a batch op on float, double or int32.
+template<typename... Ranges, typename T, typename Reduce, typename Transform>
+T zip_reduce(zip_range<Ranges...>& range, T init, Reduce reduce, Transform transform) {
+    EXP_TRACE_SCOPE("exp::zip_reduce");
+    const std::size_t n = range.size();
+    details::with_begins(range, [&](auto... its) {
+        if constexpr (zip_range<Ranges...>::is_contiguous) {
+            if constexpr (details::simd_op_of<Reduce, T> == details::simd_op::plus
+                          && details::simd_foldable<Transform, T, std::iter_value_t<decltype(its)>...>) {
+                const T* cols[] = {std::to_address(its)...};
+                init = init + details::fold_columns_sum<details::simd_op_of<Transform, T>, T, sizeof...(its)>(cols, n);
+            } else {
+                [&](auto*... cols) {
+                    for(std::size_t idx = 0; idx < n; ++idx) {
+                        init = reduce(init, transform(cols[idx]...));
+                    }
+                }(std::to_address(its)...);
+            }
+        } else {
+            for(std::size_t idx = 0; idx < n; ++idx, (++its, ...)) {
+                init = reduce(init, transform(*its...));
+            }
+        }
+    });
+    return init;
+}
+
+} // namespace exp